@@ -150,6 +150,13 @@ sub helpFor
 		$h .= "\t-su2\n";
 		$h .= "\t\t[Post]process SU(2) tests\n";
 		return $h;
+	} elsif ($label eq "-perf") {
+		$h .= "\t-perf threads\n";
+		$h .= "\t\tPerformance mode: run the tests of Ci::getPerfTests (or those\n";
+		$h .= "\t\tgiven with -n) with Threads=threads and SolverOptions telemetry.\n";
+		$h .= "\t\tSU(2) tests, like test 0, are run only if -su2 is also given.\n";
+		$h .= "\t\tThen use perfCi.pl to compare against stored baselines.\n";
+		return $h;
 	} elsif ($label eq "-h") {
 		$h .= "\t-h\n";
 		$h .= "\t\tPrint this help and exit\n";
@@ -279,6 +286,24 @@ sub readAnnotationFromKey
 	return (undef);
 }
 
+# Representative tests for the performance mode, and the
+# SolverOptions to add to each: Hubbard with SU(2),
+# Kron with KronLoadBalance, time evolution, and correction vector
+sub getPerfTests
+{
+	my %h = ("0" => "", "2" => ",KronLoadBalance", "10" => "", "3000" => "");
+	return %h;
+}
+
+# Copy of the input of test n with Threads= set; written to the working directory
+sub getPerfInputFilename
+{
+	my ($n) = @_;
+	my $file = getInputFilename($n);
+	my $ext = ($file =~ /\.ain$/) ? "ain" : "inp";
+	return "perfInput$n.$ext";
+}
+
 sub getInputFilename
 {
 	my ($n) = @_;
@@ -9,6 +9,7 @@ use EnergyAncillaInSitu;
 use CollectBrakets;
 use Metts;
 use Ndollar;
+use CompareInSitu;
 
 my ($action, $n, @what) = @ARGV;
 defined($what[0]) or die "$0: USAGE: action n what\n";
@@ -17,7 +18,8 @@ my %actions = (getTimeObservablesInSitu => \&runTimeInSituObs,
 	               getEnergyAncilla => \&runEnergyAncillaInSituObs,
 	               CollectBrakets => \&runCollectBrakets,
 	               metts => \&runMetts,
-	               nDollar => \&runNdollar);
+	               nDollar => \&runNdollar,
+	               compareInSitu => \&runCompareInSitu);
 
 defined($actions{$action}) or die "$0: Action $action not registered\n";
 
@@ -148,3 +150,24 @@ sub runNdollar
 }
 
 
+
+sub runCompareInSitu
+{
+	my ($n, $what) = @_;
+	my $nWhat = scalar(@$what);
+	die "$0: Expecting one arg\n" unless ($nWhat == 1);
+	my $fileInSitu = "runForinput$n.cout";
+	my $fileObserve = "observe$n.txt";
+	my @labels = split(/,/, $what->[0]);
+	my $fout;
+	my $foutname = "compareInSitu$n.txt";
+	open($fout, ">", "$foutname") or die "$0: Could not write to $foutname: $!\n";
+	my $failed = 0;
+	foreach my $label (@labels) {
+		my $maxDiff = CompareInSitu::main($label, $fileInSitu, $fileObserve, $fout);
+		$failed = 1 if ($maxDiff > 1e-5);
+	}
+
+	close($fout);
+	die "$0: |$n|: InSituTwoPoint differs from observe; see $foutname\n" if ($failed);
+}
@@ -6,7 +6,7 @@ use Getopt::Long qw(:config no_ignore_case);
 use lib ".";
 use Ci;
 
-my ($valgrind,$workdir,$ranges,$regex,$su2,$info,$sOptions,$help);
+my ($valgrind,$workdir,$ranges,$regex,$su2,$info,$sOptions,$perfThreads,$help);
 my %submit;
 GetOptions(
 'S=s' => \$submit{"command"},
@@ -18,6 +18,7 @@ GetOptions(
 'i=i' => \$info,
 'o=s' => \$sOptions,
 'su2' => \$su2,
+'perf=i' => \$perfThreads,
 'h' => \$help) or die "$0: Error in command line args, run with -h to display help\n";
 
 if (defined($help)) {
@@ -41,6 +42,7 @@ if (defined($help)) {
 	print "\t-i number\n";
 	print "\t\tPrint info for test number number\n";
 	print Ci::helpFor("-su2");
+	print Ci::helpFor("-perf");
 	print Ci::helpFor("-h");
 	exit(0);
 }
@@ -69,6 +71,13 @@ my @tests = Ci::getTests("../inputs/descriptions.txt");
 my %allowedTests = Ci::getAllowedTests(\@tests);
 my $total = $tests[$#tests]->{"number"};
 
+my %perfTests;
+if (defined($perfThreads)) {
+	die "$0: -perf threads must be positive\n" if ($perfThreads < 1);
+	%perfTests = Ci::getPerfTests();
+	defined($ranges) or $ranges = join(",", sort { $a <=> $b } keys %perfTests);
+}
+
 if (defined($info)) {
 	my $desc = $allowedTests{$info};
 	defined($desc) or die "$0: No test $info\n";
@@ -115,6 +124,16 @@ for (my $j = 0; $j < $rangesTotal; ++$j) {
 
 	my $whatDmrg = Ci::readAnnotationFromKey(\@ciAnnotations, "dmrg");
 	my $extraCmdArgs = $sOptions."  ".findArguments($whatDmrg);
+
+	if (defined($perfThreads)) {
+		my $extra = $perfTests{"$n"};
+		defined($extra) or $extra = "";
+		my $perfCmd = getPerfCmd($n, $perfThreads, "$extraCmdArgs -o ,telemetry$extra");
+		die "$0: Already created batch for $n\n" if defined($batches[$n]);
+		$batches[$n] = createBatch($n, $perfCmd, $submit{"PBS_O_WORKDIR"});
+		next;
+	}
+
 	my $cmd = getCmd($n, $valgrind, $extraCmdArgs);
 
 	for (my $i = 0; $i < $totalAnnotations; ++$i) {
@@ -275,6 +294,36 @@ sub getCmd
 	return "$valgrind./dmrg -f $inputfile $extraCmdArgs &> output$n.txt\n\n";
 }
 
+# Runs a copy of the input with Threads=threads, so that timings are comparable
+sub getPerfCmd
+{
+	my ($n, $threads, $extraCmdArgs) = @_;
+	my $inputfile = Ci::getInputFilename($n);
+	my $from = getRestartFrom($inputfile, $n);
+	die "$0: Test $n is a restart, not supported with -perf\n" if ($from ne "");
+
+	my $perfInput = Ci::getPerfInputFilename($n);
+	my $isAinur = ($perfInput =~ /\.ain$/);
+	my $threadsLine = ($isAinur) ? "Threads=$threads;" : "Threads=$threads";
+	open(FILE, "<", "$inputfile") or die "$0: Cannot open $inputfile : $!\n";
+	open(FOUT, ">", "$perfInput") or die "$0: Cannot write to $perfInput : $!\n";
+	my $found = 0;
+	while (<FILE>) {
+		if (/^Threads=/) {
+			$_ = "$threadsLine\n";
+			$found = 1;
+		}
+
+		print FOUT;
+	}
+
+	print FOUT "\n$threadsLine\n" if (!$found);
+	close(FOUT);
+	close(FILE);
+
+	return "./dmrg -f $perfInput $extraCmdArgs &> output$n.txt\n\n";
+}
+
 sub createBatch
 {
 	my ($ind,$cmd,$pbsOworkDir) = @_;
@@ -0,0 +1,224 @@
+#!/usr/bin/perl
+
+use strict;
+use warnings;
+use Getopt::Long qw(:config no_ignore_case);
+use lib ".";
+use Ci;
+
+my ($ranges,$workdir,$basedir,$tolerance,$save,$help);
+GetOptions(
+'n=s' => \$ranges,
+'w=s' => \$workdir,
+'b=s' => \$basedir,
+'t=s' => \$tolerance,
+'s' => \$save,
+'h' => \$help) or die "$0: Error in command line args, run with -h to display help\n";
+
+my $defaultBase = "perf";
+my $minSeconds = 0.5;
+
+if (defined($help)) {
+	print "USAGE: $0 [options]\n";
+	print "\tCompares the telemetry of runs made with ci.pl -perf threads\n";
+	print "\tagainst stored baselines, and prints REGRESSION for each\n";
+	print "\tstage time or peak memory that grew beyond the tolerance.\n";
+	print "\tExits with non-zero status if there are regressions.\n";
+	print "\tIf no option is given examines the tests of Ci::getPerfTests\n";
+	print Ci::helpFor("-n");
+	print Ci::helpFor("-w");
+	print "\t-b basedir\n";
+	print "\t\tUse basedir for baselines instead of the default of $defaultBase\n";
+	print "\t-t tolerance\n";
+	print "\t\tRelative tolerance, default 0.1; stages that took less than\n";
+	print "\t\t$minSeconds seconds in both runs are not flagged\n";
+	print "\t-s\n";
+	print "\t\tStore the current runs as baselines instead of comparing\n";
+	print Ci::helpFor("-h");
+	exit(0);
+}
+
+defined($workdir) or $workdir = "tests";
+defined($basedir) or $basedir = $defaultBase;
+defined($tolerance) or $tolerance = 0.1;
+defined($save) or $save = 0;
+
+die "$0: tolerance must be numeric\n" unless ($tolerance =~ /^[\d\.]+$/);
+
+my %perfTests = Ci::getPerfTests();
+my @tests = Ci::getTests("inputs/descriptions.txt");
+my $total = $tests[$#tests]->{"number"};
+my @inRange = (defined($ranges)) ? Ci::procRanges($ranges, $total)
+                                 : sort { $a <=> $b } keys %perfTests;
+
+die "$0: No tests specified under -n\n" if (scalar(@inRange) == 0);
+
+system("mkdir $basedir") if ($save and !(-d "$basedir"));
+
+my $regressions = 0;
+foreach my $n (@inRange) {
+	my %newValues = procTelemetry($n, $workdir);
+	next if (!%newValues);
+
+	my $baseline = "$basedir/perf$n.txt";
+	if ($save) {
+		saveBaseline(\%newValues, $baseline);
+		print "|$n|: Baseline written to $baseline\n";
+		next;
+	}
+
+	my %oldValues = loadBaseline($baseline);
+	if (!%oldValues) {
+		print "|$n|: No baseline $baseline found, run with -s to store one\n";
+		next;
+	}
+
+	$regressions += compareValues(\%newValues, \%oldValues, $n);
+	print "-----------------------------------------------\n";
+}
+
+exit(0) if ($save);
+
+print "$0: $regressions regression(s) with tolerance $tolerance\n";
+exit(($regressions > 0) ? 1 : 0);
+
+# Totals over all steps of the telemetry file of test n
+sub procTelemetry
+{
+	my ($n, $dir) = @_;
+	my $input = Ci::getInputFilename($n);
+	$input =~ s/\.\.\///;
+	my $root = getOutputRoot($input);
+	my $file = "$dir/${root}Telemetry.jsonl";
+	my %values;
+	if (!(-r "$file")) {
+		print "|$n|: No $file found\n";
+		return %values;
+	}
+
+	open(FILE, "<", "$file") or return %values;
+	my @stages = qw(grow diagonalization wft truncation io);
+	$values{$_} = 0 for (@stages);
+	$values{"solverSteps"} = 0;
+	$values{"peakRssKb"} = 0;
+	$values{"steps"} = 0;
+	while (<FILE>) {
+		chomp;
+		foreach my $stage (@stages) {
+			$values{$stage} += $1 if (/\"$stage\":([^,\}]+)/);
+		}
+
+		$values{"solverSteps"} += $1 if (/\"solverSteps\":(\d+)/);
+		if (/\"peakRssKb\":(\d+)/) {
+			$values{"peakRssKb"} = $1 if ($1 > $values{"peakRssKb"});
+		}
+
+		++$values{"steps"};
+	}
+
+	close(FILE);
+
+	# wft is part of diagonalization
+	$values{"total"} = 0;
+	$values{"total"} += $values{$_} for qw(grow diagonalization truncation io);
+	$values{"threads"} = getThreads("$dir/".Ci::getPerfInputFilename($n));
+	return %values;
+}
+
+sub getOutputRoot
+{
+	my ($file) = @_;
+	open(FILE, "<", "$file") or die "$0: Cannot open $file : $!\n";
+	my $root;
+	while (<FILE>) {
+		if (/^OutputFile=\"?([^\";\n]+)/) {
+			$root = $1;
+			last;
+		}
+	}
+
+	close(FILE);
+	defined($root) or die "$0: No OutputFile= in $file\n";
+	$root =~ s/\.[^\.\/]+$//;
+	return $root;
+}
+
+sub getThreads
+{
+	my ($file) = @_;
+	open(FILE, "<", "$file") or return "UNDEFINED";
+	my $threads = "UNDEFINED";
+	while (<FILE>) {
+		if (/^Threads=(\d+)/) {
+			$threads = $1;
+			last;
+		}
+	}
+
+	close(FILE);
+	return $threads;
+}
+
+sub saveBaseline
+{
+	my ($values, $file) = @_;
+	open(FOUT, ">", "$file") or die "$0: Cannot write to $file : $!\n";
+	foreach my $key (sort keys %$values) {
+		print FOUT "$key ".$values->{$key}."\n";
+	}
+
+	close(FOUT);
+}
+
+sub loadBaseline
+{
+	my ($file) = @_;
+	my %values;
+	open(FILE, "<", "$file") or return %values;
+	while (<FILE>) {
+		chomp;
+		my @temp = split;
+		next if (scalar(@temp) != 2);
+		$values{$temp[0]} = $temp[1];
+	}
+
+	close(FILE);
+	return %values;
+}
+
+sub compareValues
+{
+	my ($newValues, $oldValues, $n) = @_;
+	my $regressions = 0;
+
+	if ($newValues->{"threads"} ne $oldValues->{"threads"}) {
+		print "|$n|: WARNING: threads ".$newValues->{"threads"};
+		print " but baseline has ".$oldValues->{"threads"}."\n";
+	}
+
+	foreach my $key (qw(steps solverSteps)) {
+		my $v1 = $newValues->{$key};
+		my $v2 = $oldValues->{$key};
+		next if (defined($v2) and $v1 == $v2);
+		defined($v2) or $v2 = "UNDEFINED";
+		print "|$n|: WARNING: $key $v1 but baseline has $v2; runs may not be comparable\n";
+	}
+
+	foreach my $key (qw(total grow diagonalization wft truncation io peakRssKb)) {
+		my $v1 = $newValues->{$key};
+		my $v2 = $oldValues->{$key};
+		defined($v2) or next;
+		my $ratio = ($v2 > 0) ? sprintf("%.3f", $v1/$v2) : "INF";
+		my $flag = "";
+		my $isTime = ($key ne "peakRssKb");
+		my $small = ($isTime and $v1 < $minSeconds and $v2 < $minSeconds);
+		if (!$small and $v1 > $v2*(1 + $tolerance)) {
+			$flag = " REGRESSION";
+			++$regressions;
+		}
+
+		print "|$n|: $key: $v1 $v2 ratio=$ratio$flag\n";
+	}
+
+	return $regressions;
+}
@@ -0,0 +1,70 @@
+#!/usr/bin/perl
+
+use strict;
+use warnings;
+use utf8;
+
+package CompareInSitu;
+
+# Compares the matrix of label printed by InSituTwoPoint in fileInSitu
+# with the one printed by observe in fileObserve.
+# Entries that are zero in situ (below the diagonal, sites not passed,
+# and the last site) are not compared.
+sub main
+{
+	my ($label, $fileInSitu, $fileObserve, $fout) = @_;
+	my @inSitu = readMatrix($label, $fileInSitu);
+	my @observe = readMatrix($label, $fileObserve);
+	my $rows = scalar(@inSitu);
+	(scalar(@observe) == $rows) or die "$0: $label: rows differ\n";
+
+	my $maxDiff = 0;
+	my $compared = 0;
+	for (my $i = 0; $i < $rows; ++$i) {
+		my $cols = scalar(@{$inSitu[$i]});
+		(scalar(@{$observe[$i]}) == $cols) or die "$0: $label: columns differ\n";
+		for (my $j = 0; $j < $cols; ++$j) {
+			my $x = $inSitu[$i]->[$j];
+			next if ($x == 0);
+			my $diff = abs($x - $observe[$i]->[$j]);
+			$maxDiff = $diff if ($diff > $maxDiff);
+			++$compared;
+		}
+	}
+
+	print $fout "$label compared=$compared maxDiff=$maxDiff\n";
+	return $maxDiff;
+}
+
+sub readMatrix
+{
+	my ($label, $file) = @_;
+	open(FILE, "<", $file) or die "$0: Cannot open $file : $!\n";
+	my @m;
+	my $afterLabel = 0;
+	while (<FILE>) {
+		chomp;
+		my @temp = split;
+		my $isHeader = (scalar(@temp) == 2 && $temp[0] =~ /^\d+$/ && $temp[1] =~ /^\d+$/);
+		if (!$afterLabel || !$isHeader) {
+			$afterLabel = (/\Q$label/) ? 1 : 0;
+			next;
+		}
+
+		$afterLabel = 0;
+		my ($rows, $cols) = @temp;
+		for (my $i = 0; $i < $rows; ++$i) {
+			$_ = <FILE>;
+			defined($_) or die "$0: $file: $label: matrix ends early\n";
+			my @row = split;
+			(scalar(@row) == $cols) or die "$0: $file: $label: row $i\n";
+			$m[$i] = \@row;
+		}
+	}
+
+	close(FILE);
+	(scalar(@m) > 0) or die "$0: $file: $label not found\n";
+	return @m;
+}
+
+1;
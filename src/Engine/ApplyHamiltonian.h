@@ -54,6 +54,7 @@ private:
 		                             model_.modelLinks(),
 		                             physicalTime_,
 		                             0);
+		hc.buildOperators();
 		MatrixForApplicationType lanczosHelper(model_, hc);
 
 		SizeType total = phi.effectiveSize(i0);
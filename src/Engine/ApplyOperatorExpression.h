@@ -82,6 +82,7 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include "StageEnum.h"
 #include "MultiSiteExpressionHelper.h"
 #include "CorrelationsSkeleton.h"
+#include "LanczosMatrixCache.h"
 
 namespace Dmrg {
 
@@ -123,6 +124,8 @@ public:
 	MultiSiteExpressionHelperType;
 	typedef typename MultiSiteExpressionHelperType::DmrgSerializerType DmrgSerializerType;
 	typedef CorrelationsSkeleton<MultiSiteExpressionHelperType, ModelType> CorrelationsSkeletonType;
+	typedef LanczosMatrixCache<ModelType, typename LanczosSolverType::MatrixType>
+	LanczosMatrixCacheType;
 
 	ApplyOperatorExpression(const TargetHelperType& targetHelper,
 	                        SizeType indexNoAdvance)
@@ -135,7 +138,8 @@ public:
 	      targetVectors_(0),
 	      timeVectorsBase_(0),
 	      multiSiteExprHelper_(targetHelper_.model().geometry().numberOfSites() - 2),
-	      correlationsSkel_(multiSiteExprHelper_, false)
+	      correlationsSkel_(multiSiteExprHelper_, false, 1),
+	      lanczosMatrices_(targetHelper.model(), targetHelper.lrs())
 	{}
 
 	~ApplyOperatorExpression()
@@ -242,6 +246,10 @@ public:
 		stage_[ind] = x;
 	}
 
+	const LanczosMatrixCacheType& lanczosMatrices() const { return lanczosMatrices_; }
+
+	void clearLanczosMatrices() { lanczosMatrices_.clear(); }
+
 	const RealType& energy() const
 	{
 		return E0_;
@@ -309,6 +317,7 @@ public:
 			                                             model,
 			                                             wft,
 			                                             lrs,
+			                                             lanczosMatrices_,
 			                                             E0_,
 			                                             ioIn);
 			break;
@@ -319,6 +328,7 @@ public:
 			                                                model,
 			                                                wft,
 			                                                lrs,
+			                                                lanczosMatrices_,
 			                                                E0_,
 			                                                ioIn);
 			break;
@@ -329,6 +339,7 @@ public:
 			                                                 model,
 			                                                 wft,
 			                                                 lrs,
+			                                                 lanczosMatrices_,
 			                                                 E0_);
 			break;
 		case TargetParamsType::AlgorithmEnum::SUZUKI_TROTTER:
@@ -650,6 +661,7 @@ private:
 	TimeVectorsBaseType* timeVectorsBase_;
 	mutable MultiSiteExpressionHelperType multiSiteExprHelper_;
 	CorrelationsSkeletonType correlationsSkel_;
+	LanczosMatrixCacheType lanczosMatrices_;
 };
 
 } // namespace Dmrg
@@ -79,9 +79,11 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #ifndef APPLY_OPERATOR_LOCAL_H
 #define APPLY_OPERATOR_LOCAL_H
 
-#include "PackIndices.h" // in PsimagLite
 #include "FermionSign.h"
 #include "ProgramGlobals.h"
+#include "Concurrency.h"
+#include "SectorChunks.h"
+#include <algorithm>
 
 namespace Dmrg {
 
@@ -92,8 +94,10 @@ class ApplyOperatorLocal {
 	typedef typename LeftRightSuperType_::BasisWithOperatorsType BasisWithOperatorsType;
 	typedef typename BasisWithOperatorsType::RealType RealType;
 	typedef typename BasisWithOperatorsType::ComplexOrRealType ComplexOrRealType;
-	typedef PsimagLite::PackIndices PackIndicesType;
 	typedef typename BasisWithOperatorsType::OperatorType OperatorType_;
+	typedef typename OperatorType_::StorageType SparseMatrixType;
+	typedef typename PsimagLite::Vector<SizeType>::Type VectorSizeType;
+	typedef typename PsimagLite::Vector<bool>::Type VectorBoolType;
 
 	class LegacyBug {
 
@@ -147,8 +151,12 @@ public:
 	typedef OperatorType_ OperatorType;
 	typedef FermionSign FermionSignType;
 
-	ApplyOperatorLocal(const LeftRightSuperType& lrs, bool withLegacyBug)
-	    : lrs_(lrs), withLegacyBug_(withLegacyBug)
+	// threads is the number of threads an application may use; give 1
+	// when applying inside an outer parallel loop
+	ApplyOperatorLocal(const LeftRightSuperType& lrs,
+	                   bool withLegacyBug,
+	                   SizeType threads = PsimagLite::Concurrency::codeSectionParams.npthreads)
+	    : lrs_(lrs), withLegacyBug_(withLegacyBug), threads_(threads)
 	{}
 
 	//! FIXME: we need to make a fast version for when we're just
@@ -164,286 +172,339 @@ public:
 		const OperatorType& A = legacyBug();
 
 		if (corner == BORDER_NO) {
-			if (systemOrEnviron == ProgramGlobals::DirectionEnum::EXPAND_SYSTEM)
-				applyLocalOpSystem(dest,src,A,fermionSign);
-			else
-				applyLocalOpEnviron(dest,src,A);
+			if (systemOrEnviron == ProgramGlobals::DirectionEnum::EXPAND_SYSTEM) {
+				if (src.size() != lrs_.super().permutationVector().size())
+					err("applyLocalOpSystem SE\n");
+				applyLocalOp(dest,src,A,ApplyEnum::SYSTEM,&fermionSign);
+			} else {
+				applyLocalOp(dest,src,A,ApplyEnum::ENVIRON,0);
+			}
+
+			return;
+		}
+
+		// corner cases. These are all when expanding ths system
+		if (lrs_.right().size() == A.data.rows()) { // right corner
+			if (src.size() != lrs_.super().permutationVector().size())
+				err("applyLocalOpSystem SE\n");
+			applyLocalOp(dest,src,A,ApplyEnum::RIGHT_CORNER,0);
 			return;
 		}
 
-		applyLocalOpCorner(dest,src,A,fermionSign);
+		applyLocalOp(dest,src,A,ApplyEnum::LEFT_CORNER,0);
 	}
 
 	//! FIXME: we need to make a fast version for when we're just
 	//! figuring out where the (non-zero) partition is
+	// dest = transpose(A) * src with A acting on the first part of the
+	// left block; corrected if !withLegacyBug
 	void hookForZero(VectorWithOffsetType& dest,
 	                 const VectorWithOffsetType& src,
-	                 const OperatorType& A,
-	                 const FermionSign& fermionSign,
+	                 const OperatorType& AA,
+	                 const FermionSign&,
 	                 ProgramGlobals::DirectionEnum systemOrEnviron) const
 	{
 		assert(systemOrEnviron == ProgramGlobals::DirectionEnum::EXPAND_SYSTEM);
 
-		TargetVectorType dest2(lrs_.super().size(),0.0);
-
-		for (SizeType ii = 0; ii < src.sectors(); ++ii) {
-			SizeType i = src.sector(ii);
-			hookForZeroSystem(dest2,src,A,fermionSign,i);
-		}
-
-		dest.fromFull(dest2,lrs_.super());
-	}
-
-	// dest2 = transpose(A) * src; corrected if !withLegacyBug
-	void hookForZeroSystem(TargetVectorType& dest2,
-	                       const VectorWithOffsetType& src,
-	                       const OperatorType& AA,
-	                       const FermionSign&,
-	                       SizeType i0) const
-	{
 		LegacyBug legacyBug(withLegacyBug_, AA);
 		const OperatorType& A = legacyBug();
 
-		SizeType offset = src.offset(i0);
-		SizeType final = offset + src.effectiveSize(i0);
-		SizeType ns = lrs_.left().permutationVector().size();
-		SizeType nx = ns/A.data.rows();
 		if (src.size() != lrs_.super().permutationVector().size())
 			err("applyLocalOpSystem SE\n");
 
-		PackIndicesType pack1(ns);
-		PackIndicesType pack2(nx);
-		for (SizeType i = offset; i < final; ++i) {
-			SizeType x = 0;
-			SizeType y  = 0;
-			pack1.unpack(x,y,lrs_.super().permutation(i));
-
-			SizeType x0 = 0;
-			SizeType x1 = 0;
-			assert(x<lrs_.left().permutationVector().size());
-			pack2.unpack(x0,x1,lrs_.left().permutation(x));
-
-			SizeType start = A.data.getRowPtr(x0);
-			SizeType end = A.data.getRowPtr(x0 + 1);
-			for (SizeType k = start; k < end; ++k) {
-				SizeType x0prime = A.data.getCol(k);
-				SizeType xprime = lrs_.left().permutationInverse(x0prime+x1*nx);
-				SizeType j = lrs_.super().permutationInverse(xprime+y*ns);
-				dest2[j] += src.slowAccess(i)*A.data.getValue(k);
-			}
-		}
+		applyLocalOp(dest,src,A,ApplyEnum::HOOK_FOR_ZERO,0);
 	}
 
 	const LeftRightSuperType& lrs() const { return lrs_; }
 
 private:
 
-	ApplyOperatorLocal(const ApplyOperatorLocal&);
+	// where A acts:
+	// SYSTEM on the last site of the left block, x = x0 + x1*nx, A on x1
+	// HOOK_FOR_ZERO on the first part of the left block, A on x0
+	// ENVIRON on the first site of the right block, y = y0 + y1*ny, A on y0
+	// LEFT_CORNER on the whole left block
+	// RIGHT_CORNER on the whole right block
+	enum class ApplyEnum {SYSTEM, HOOK_FOR_ZERO, ENVIRON, LEFT_CORNER, RIGHT_CORNER};
 
-	ApplyOperatorLocal& operator=(const ApplyOperatorLocal&);
+	// Indices of the superblock for applying A, shared by the tasks below.
+	// The fermionic sign of a state and of the state it comes from are the same.
+	class LocalIndices {
 
-	void applyLocalOpSystem(VectorWithOffsetType& dest,
-	                        const VectorWithOffsetType& src,
-	                        const OperatorType& A,
-	                        const FermionSign& fermionSign,
-	                        SizeType whichPartOfTheLattice = MIDDLE) const
-	{
-		TargetVectorType dest2(lrs_.super().size(),0.0);
+	public:
 
-		for (SizeType ii=0;ii<src.sectors();ii++) {
-			SizeType i = src.sector(ii);
-			switch (whichPartOfTheLattice) {
-			case MIDDLE:
-				applyLocalOpSystem(dest2,src,A,fermionSign,i);
+		LocalIndices(const LeftRightSuperType& lrs,
+		             const OperatorType& A,
+		             ApplyEnum kind,
+		             const FermionSign* fermionSign)
+		    : lrs_(lrs),
+		      A_(A.data),
+		      kind_(kind),
+		      fermionSign_(fermionSign),
+		      superPerm_(lrs.super().permutationVector()),
+		      superPermInverse_(lrs.super().permutationInverse()),
+		      leftPerm_(lrs.left().permutationVector()),
+		      leftPermInverse_(lrs.left().permutationInverse()),
+		      rightPerm_(lrs.right().permutationVector()),
+		      rightPermInverse_(lrs.right().permutationInverse()),
+		      ns_(lrs.left().size()),
+		      nx_(0),
+		      f_((A.fermionOrBoson == ProgramGlobals::FermionOrBosonEnum::FERMION) ? -1 : 1)
+		{
+			switch (kind_) {
+			case ApplyEnum::SYSTEM:
+			case ApplyEnum::HOOK_FOR_ZERO:
+				nx_ = ns_/A_.rows();
+				break;
+			case ApplyEnum::ENVIRON:
+				nx_ = A_.rows();
 				break;
-			case LEFT_CORNER:
-				throw PsimagLite::RuntimeError("applyLocalOpSystem: internal error\n");
-			case RIGHT_CORNER:
-				applyLocalOpRightCorner(dest2,src,A,i);
+			default:
 				break;
 			}
+
+			// dest(j) = sum_i A(i, j) src(i), so rows of the transpose are needed
+			transposeConjugate(At_, A_);
+			At_.conjugate();
+
+			const SizeType partitions = lrs.super().partition();
+			partitions_.resize(partitions);
+			for (SizeType i = 0; i < partitions; ++i)
+				partitions_[i] = lrs.super().partition(i);
 		}
 
-		dest.fromFull(dest2,lrs_.super());
-	}
+		const SparseMatrixType& A() const { return A_; }
 
-	// dest2 = transpose(A) * src; corrected if !withLegacyBug
-	void applyLocalOpSystem(TargetVectorType& dest2,
-	                        const VectorWithOffsetType& src,
-	                        const OperatorType& A,
-	                        const FermionSign& fermionSign,
-	                        SizeType i0) const
-	{
-		SizeType offset = src.offset(i0);
-		SizeType final = offset + src.effectiveSize(i0);
-		SizeType ns = lrs_.left().permutationVector().size();
-		SizeType nx = ns/A.data.rows();
-		if (src.size() != lrs_.super().permutationVector().size())
-			err("applyLocalOpSystem SE\n");
+		const SparseMatrixType& At() const { return At_; }
+
+		const VectorSizeType& partitions() const { return partitions_; }
 
-		PackIndicesType pack1(ns);
-		PackIndicesType pack2(nx);
-		for (SizeType i = offset; i < final; ++i) {
-			SizeType x = 0;
-			SizeType y = 0;
-			pack1.unpack(x,y,lrs_.super().permutation(i));
-
-			SizeType x0 = 0;
-			SizeType x1 = 0;
-			assert(x<lrs_.left().permutationVector().size());
-			pack2.unpack(x0,x1,lrs_.left().permutation(x));
-
-			const bool isFermion = (A.fermionOrBoson ==
-			                        ProgramGlobals::FermionOrBosonEnum::FERMION);
-			const RealType sign = fermionSign(x0, (isFermion) ? -1 : 1);
-			const SizeType start = A.data.getRowPtr(x1);
-			const SizeType end = A.data.getRowPtr(x1 + 1);
-			for (SizeType k = start; k < end; ++k) {
-				SizeType x1prime = A.data.getCol(k);
-				SizeType xprime = lrs_.left().permutationInverse(x0+x1prime*nx);
-				SizeType j = lrs_.super().permutationInverse(xprime+y*ns);
-				dest2[j] += src.slowAccess(i)*A.data.getValue(k)*sign;
+		// the local index of state t of the superblock that A acts on
+		SizeType local(SizeType t) const
+		{
+			const SizeType p = superPerm_[t];
+			const SizeType x = p % ns_;
+			const SizeType y = p/ns_;
+			switch (kind_) {
+			case ApplyEnum::SYSTEM:
+				return leftPerm_[x]/nx_;
+			case ApplyEnum::HOOK_FOR_ZERO:
+				return leftPerm_[x] % nx_;
+			case ApplyEnum::ENVIRON:
+				return rightPerm_[y] % nx_;
+			case ApplyEnum::LEFT_CORNER:
+				return x;
+			case ApplyEnum::RIGHT_CORNER:
+			default:
+				return y;
 			}
 		}
-	}
 
-	void applyLocalOpEnviron(VectorWithOffsetType& dest,
-	                         const VectorWithOffsetType& src,
-	                         const OperatorType& A,
-	                         SizeType whichPartOfTheLattice = MIDDLE) const
-	{
-		TargetVectorType dest2(lrs_.super().size(),0.0);
+		// state t of the superblock with its local index replaced by l
+		SizeType replaceLocal(SizeType t, SizeType l) const
+		{
+			const SizeType p = superPerm_[t];
+			const SizeType x = p % ns_;
+			const SizeType y = p/ns_;
+			switch (kind_) {
+			case ApplyEnum::SYSTEM: {
+				const SizeType x0 = leftPerm_[x] % nx_;
+				return superPermInverse_[leftPermInverse_[x0 + l*nx_] + y*ns_];
+			}
+			case ApplyEnum::HOOK_FOR_ZERO: {
+				const SizeType x1 = leftPerm_[x]/nx_;
+				return superPermInverse_[leftPermInverse_[l + x1*nx_] + y*ns_];
+			}
+			case ApplyEnum::ENVIRON: {
+				const SizeType y1 = rightPerm_[y]/nx_;
+				return superPermInverse_[x + rightPermInverse_[l + y1*nx_]*ns_];
+			}
+			case ApplyEnum::LEFT_CORNER:
+				return superPermInverse_[l + y*ns_];
+			case ApplyEnum::RIGHT_CORNER:
+			default:
+				return superPermInverse_[x + l*ns_];
+			}
+		}
 
-		for (SizeType ii=0;ii<src.sectors();ii++) {
-			SizeType i = src.sector(ii);
-			switch (whichPartOfTheLattice) {
-			case MIDDLE:
-				applyLocalOpEnviron(dest2,src,A,i);
-				break;
-			case LEFT_CORNER:
-				applyLocalOpLeftCorner(dest2,src,A,i);
-				break;
-			case RIGHT_CORNER:
-				err("applyLocalOpEnviron: internal error\n");
+		RealType sign(SizeType t) const
+		{
+			if (f_ == 1) return 1.0;
+
+			const SizeType x = superPerm_[t] % ns_;
+			switch (kind_) {
+			case ApplyEnum::SYSTEM:
+				return (*fermionSign_)(leftPerm_[x] % nx_, f_);
+			case ApplyEnum::ENVIRON:
+			case ApplyEnum::RIGHT_CORNER:
+				return lrs_.left().fermionicSign(x, f_);
+			default:
+				return 1.0;
 			}
 		}
 
-		dest.fromFull(dest2,lrs_.super());
-	}
+		SizeType partitionOf(SizeType j) const
+		{
+			typename VectorSizeType::const_iterator it = std::upper_bound(partitions_.begin(),
+			                                                              partitions_.end(),
+			                                                              j);
+			assert(it != partitions_.begin() && it != partitions_.end());
+			return (it - partitions_.begin()) - 1;
+		}
 
-	// dest2 = transpose(A) * src; corrected if !withLegacyBug
-	void applyLocalOpEnviron(TargetVectorType& dest2,
-	                         const VectorWithOffsetType& src,
-	                         const OperatorType& A,
-	                         SizeType i0) const
-	{
-		SizeType offset = src.offset(i0);
-		SizeType final = offset + src.effectiveSize(i0);
-
-		SizeType ns = lrs_.left().size();
-		SizeType nx = A.data.rows();
-		PackIndicesType pack1(ns);
-		PackIndicesType pack2(nx);
-
-		for (SizeType i = offset; i < final; ++i) {
-			SizeType x = 0;
-			SizeType y = 0;
-			pack1.unpack(x,y,lrs_.super().permutation(i));
-			SizeType y0 = 0;
-			SizeType y1 = 0;
-			pack2.unpack(y0,y1,lrs_.right().permutation(y));
-			const bool isFermion = (A.fermionOrBoson ==
-			                        ProgramGlobals::FermionOrBosonEnum::FERMION);
-			const RealType sign = lrs_.left().fermionicSign(x, (isFermion) ? -1 : 1);
-			const SizeType start = A.data.getRowPtr(y0);
-			const SizeType end = A.data.getRowPtr(y0 + 1);
-			for (SizeType k = start; k < end; ++k) {
-				SizeType y0prime = A.data.getCol(k);
-				SizeType yprime = lrs_.right().permutationInverse(y0prime+y1*nx);
-				SizeType j = lrs_.super().permutationInverse(x+yprime*ns);
-				dest2[j] += src.slowAccess(i)*A.data.getValue(k)*sign;
+	private:
+
+		const LeftRightSuperType& lrs_;
+		const SparseMatrixType& A_;
+		SparseMatrixType At_;
+		ApplyEnum kind_;
+		const FermionSign* fermionSign_;
+		const VectorSizeType& superPerm_;
+		const VectorSizeType& superPermInverse_;
+		const VectorSizeType& leftPerm_;
+		const VectorSizeType& leftPermInverse_;
+		const VectorSizeType& rightPerm_;
+		const VectorSizeType& rightPermInverse_;
+		SizeType ns_;
+		SizeType nx_;
+		int f_;
+		VectorSizeType partitions_;
+	}; // class LocalIndices
+
+	// Marks, for each chunk of the states of src, the partitions of the
+	// superblock that A takes those states to
+	class FindTargets {
+
+	public:
+
+		FindTargets(const LocalIndices& indices,
+		            const TargetVectorType& src,
+		            const SectorChunks& chunks)
+		    : indices_(indices), src_(src), chunks_(chunks), targets_(chunks.size())
+		{}
+
+		void doTask(SizeType taskNumber, SizeType)
+		{
+			const SectorChunks::Chunk& chunk = chunks_[taskNumber];
+			const SparseMatrixType& A = indices_.A();
+			VectorBoolType& targets = targets_[taskNumber];
+			targets.assign(indices_.partitions().size(), false);
+			for (SizeType i = chunk.start; i < chunk.end; ++i) {
+				if (src_[i] == static_cast<ComplexOrRealType>(0.0)) continue;
+
+				const SizeType row = indices_.local(i);
+				for (int k = A.getRowPtr(row); k < A.getRowPtr(row + 1); ++k)
+					targets[indices_.partitionOf(indices_.replaceLocal(i, A.getCol(k)))] = true;
 			}
 		}
-	}
 
-	// dest2 = transpose(A) * src; corrected if !withLegacyBug
-	void applyLocalOpLeftCorner(TargetVectorType& dest2,
-	                            const VectorWithOffsetType& src,
-	                            const OperatorType& A,
-	                            SizeType i0) const
-	{
-		SizeType offset = src.offset(i0);
-		SizeType final = offset + src.effectiveSize(i0);
-
-		SizeType ns = lrs_.left().size();
-		PackIndicesType pack(ns);
-
-		for (SizeType i = offset; i < final; ++i) {
-			SizeType x = 0;
-			SizeType y = 0;
-			pack.unpack(x,y,lrs_.super().permutation(i));
-
-			const SizeType start = A.data.getRowPtr(x);
-			const SizeType end = A.data.getRowPtr(x + 1);
-			for (SizeType k = start; k < end; ++k) {
-				SizeType xprime = A.data.getCol(k);
-				SizeType j = lrs_.super().permutationInverse(xprime+y*ns);
-				dest2[j] += src.slowAccess(i)*A.data.getValue(k);
-			}
+		SizeType tasks() const { return chunks_.size(); }
+
+		// true for each partition marked by any chunk
+		void isTarget(VectorBoolType& result) const
+		{
+			result.assign(indices_.partitions().size(), false);
+			for (SizeType t = 0; t < targets_.size(); ++t)
+				for (SizeType p = 0; p < targets_[t].size(); ++p)
+					if (targets_[t][p]) result[p] = true;
 		}
-	}
 
-	// dest2 = transpose(A) * src; corrected if !withLegacyBug
-	void applyLocalOpRightCorner(TargetVectorType& dest2,
-	                             const VectorWithOffsetType& src,
-	                             const OperatorType& A,
-	                             SizeType i0) const
-	{
-		SizeType offset = src.offset(i0);
-		SizeType final = offset + src.effectiveSize(i0);
-		SizeType ns = lrs_.left().permutationVector().size();
-		if (src.size() != lrs_.super().permutationVector().size())
-			err("applyLocalOpSystem SE\n");
+	private:
+
+		const LocalIndices& indices_;
+		const TargetVectorType& src_;
+		const SectorChunks& chunks_;
+		typename PsimagLite::Vector<VectorBoolType>::Type targets_;
+	}; // class FindTargets
+
+	// Computes dest for each state of the chunks from the states of src it
+	// comes from, so that each task writes only its own entries of dest
+	class ApplyChunks {
+
+	public:
 
-		PackIndicesType pack(ns);
-
-		for (SizeType i = offset; i < final; ++i) {
-			SizeType x = 0;
-			SizeType y = 0;
-			pack.unpack(x,y,lrs_.super().permutation(i));
-
-			if (x >= lrs_.left().permutationVector().size())
-				err("applyLocalOpSystem S\n");
-
-			const bool isFermion = (A.fermionOrBoson ==
-			                        ProgramGlobals::FermionOrBosonEnum::FERMION);
-			const RealType sign = lrs_.left().fermionicSign(x, (isFermion) ? -1 : 1);
-			const SizeType start = A.data.getRowPtr(y);
-			const SizeType end = A.data.getRowPtr(y + 1);
-			for (SizeType k = start; k < end; ++k) {
-				SizeType yprime = A.data.getCol(k);
-				SizeType j = lrs_.super().permutationInverse(x+yprime*ns);
-				dest2[j] += src.slowAccess(i)*A.data.getValue(k)*sign;
+		ApplyChunks(const LocalIndices& indices,
+		            const TargetVectorType& src,
+		            TargetVectorType& dest,
+		            const SectorChunks& chunks)
+		    : indices_(indices), src_(src), dest_(dest), chunks_(chunks)
+		{}
+
+		void doTask(SizeType taskNumber, SizeType)
+		{
+			const SectorChunks::Chunk& chunk = chunks_[taskNumber];
+			const SparseMatrixType& At = indices_.At();
+			for (SizeType j = chunk.start; j < chunk.end; ++j) {
+				const SizeType row = indices_.local(j);
+				ComplexOrRealType sum = 0.0;
+				for (int k = At.getRowPtr(row); k < At.getRowPtr(row + 1); ++k)
+					sum += src_[indices_.replaceLocal(j, At.getCol(k))]*At.getValue(k);
+
+				dest_[j] = sum*indices_.sign(j);
 			}
 		}
-	}
 
-	// entry point for corner cases. These are all when expanding ths system
-	void applyLocalOpCorner(VectorWithOffsetType& dest,
-	                        const VectorWithOffsetType& src,
-	                        const OperatorType& A,
-	                        const FermionSign& fermionSign) const
+		SizeType tasks() const { return chunks_.size(); }
+
+	private:
+
+		const LocalIndices& indices_;
+		const TargetVectorType& src_;
+		TargetVectorType& dest_;
+		const SectorChunks& chunks_;
+	}; // class ApplyChunks
+
+	ApplyOperatorLocal(const ApplyOperatorLocal&);
+
+	ApplyOperatorLocal& operator=(const ApplyOperatorLocal&);
+
+	// dest = transpose(A) * src; corrected if !withLegacyBug
+	void applyLocalOp(VectorWithOffsetType& dest,
+	                  const VectorWithOffsetType& src,
+	                  const OperatorType& A,
+	                  ApplyEnum kind,
+	                  const FermionSign* fermionSign) const
 	{
-		if (lrs_.right().size() == A.data.rows()) { // right corner
-			applyLocalOpSystem(dest,src,A,fermionSign,RIGHT_CORNER);
-			return;
+		TargetVectorType src2(lrs_.super().size(),0.0);
+		for (SizeType ii = 0; ii < src.sectors(); ++ii) {
+			const SizeType i0 = src.sector(ii);
+			const SizeType offset = src.offset(i0);
+			const SizeType total = src.effectiveSize(i0);
+			for (SizeType i = 0; i < total; ++i)
+				src2[i + offset] = src.fastAccess(i0, i);
+		}
+
+		const LocalIndices indices(lrs_, A, kind, fermionSign);
+
+		// first the partitions that the states of src reach...
+		SectorChunks chunks(threads_);
+		for (SizeType ii = 0; ii < src.sectors(); ++ii) {
+			const SizeType i0 = src.sector(ii);
+			const SizeType offset = src.offset(i0);
+			chunks.push(i0, offset, offset + src.effectiveSize(i0));
 		}
 
-		applyLocalOpEnviron(dest,src,A,LEFT_CORNER);
+		FindTargets findTargets(indices, src2, chunks);
+		chunks.loop(findTargets);
+
+		// ...then dest in those partitions
+		VectorBoolType isTarget;
+		findTargets.isTarget(isTarget);
+		const VectorSizeType& partitions = indices.partitions();
+		chunks.clear();
+		for (SizeType p = 0; p + 1 < partitions.size(); ++p)
+			if (isTarget[p]) chunks.push(p, partitions[p], partitions[p + 1]);
+
+		TargetVectorType dest2(lrs_.super().size(),0.0);
+		ApplyChunks applyChunks(indices, src2, dest2, chunks);
+		chunks.loop(applyChunks);
+
+		dest.fromFull(dest2,lrs_.super());
 	}
 
 	const LeftRightSuperType& lrs_;
 	bool withLegacyBug_;
+	SizeType threads_;
 }; // class ApplyOperatorLocal
 } // namespace Dmrg
 
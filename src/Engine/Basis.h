@@ -397,6 +397,26 @@ public:
 		return (signs_[i]) ? f : 1;
 	}
 
+	//! Returns true if an odd number of states have odd electrons;
+	//! all states of a partition have the same sign, so only the
+	//! first state of each partition is looked at
+	bool oddNumberOfOddStates() const
+	{
+		if (signs_.size() == 0) return false;
+
+		SizeType n = partition_.size();
+		assert(n > 0 && partition_[n - 1] == signs_.size());
+		bool odd = false;
+		for (SizeType p = 0; p + 1 < n; ++p) {
+			SizeType start = partition_[p];
+			SizeType end = partition_[p + 1];
+			if (start == end || !signs_[start]) continue;
+			odd ^= ((end - start) & 1);
+		}
+
+		return odd;
+	}
+
 	//! Returns the (j,m) for state i of this basis
 	PairType jmValue(SizeType i) const
 	{
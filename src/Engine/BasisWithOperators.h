@@ -170,6 +170,16 @@ public:
 		operators_.clear();
 	}
 
+	// copies b, but only the operators in startEnd, the only ones
+	// that truncateBasis will transform; the others are left empty
+	void copyForTruncation(const BasisWithOperators& b, const PairSizeSizeType& startEnd)
+	{
+		BaseType& base = *this;
+		base = static_cast<const BaseType&>(b);
+		operatorsPerSite_ = b.operatorsPerSite_;
+		operators_.copyOperators(b.operators_, startEnd);
+	}
+
 	// set this basis to the outer product of
 	// basis2 and basis3 or basis3 and basis2  depending on dir
 	void setToProduct(const ThisType& basis2,
@@ -258,6 +268,12 @@ public:
 		return operators_.getOperatorByIndex(i);
 	}
 
+	// see Operators::build
+	void buildOperators(const VectorSizeType& indices) const
+	{
+		operators_.build(indices);
+	}
+
 	const OperatorType& getReducedOperatorByIndex(int i) const
 	{
 		return operators_.getReducedOperatorByIndex(i);
@@ -321,58 +337,27 @@ private:
 		// reorder the basis
 		parent.setToProduct(basis2, basis3);
 
-		typename PsimagLite::Vector<RealType>::Type fermionicSigns;
 		SizeType x = basis2.numberOfOperators()+basis3.numberOfOperators();
 
 		if (this->useSu2Symmetry()) setMomentumOfOperators(basis2);
 		operators_.setToProduct(basis2,basis3,x,this);
 		ApplyFactors<FactorsType> apply(this->getFactors(),this->useSu2Symmetry());
-		ProgramGlobals::FermionOrBosonEnum savedSign = ProgramGlobals::FermionOrBosonEnum::BOSON;
-
-		for (SizeType i=0;i<this->numberOfOperators();i++) {
-			if (i<basis2.numberOfOperators()) {
-				if (!this->useSu2Symmetry()) {
-					const OperatorType& myOp =  basis2.getOperatorByIndex(i);
-					bool isFermion = (myOp.fermionOrBoson ==
-					                  ProgramGlobals::FermionOrBosonEnum::FERMION);
-					if (savedSign != myOp.fermionOrBoson || fermionicSigns.size() == 0) {
-						utils::fillFermionicSigns(fermionicSigns,
-						                          basis2.signs(),
-						                          (isFermion) ? -1 : 1);
-						savedSign = myOp.fermionOrBoson;
-					}
-
-					operators_.externalProduct(i,
-					                           myOp,
-					                           basis3.size(),
-					                           fermionicSigns,
-					                           true,
-					                           apply);
-				} else {
+
+		if (!this->useSu2Symmetry()) {
+			// outer product and reordering in a single pass
+			operators_.externalProduct(basis2.operators_,
+			                           basis3.operators_,
+			                           basis2.signs(),
+			                           BaseType::permutationVector(),
+			                           BaseType::permutationInverse());
+		} else {
+			for (SizeType i=0;i<this->numberOfOperators();i++) {
+				if (i<basis2.numberOfOperators()) {
 					operators_.externalProductReduced(i,
 					                                  basis2,
 					                                  basis3,
 					                                  true,
 					                                  basis2.getReducedOperatorByIndex(i));
-				}
-			} else {
-				if (!this->useSu2Symmetry()) {
-					const OperatorType& myOp = basis3.
-					        getOperatorByIndex(i - basis2.numberOfOperators());
-					bool isFermion = (myOp.fermionOrBoson ==
-					                  ProgramGlobals::FermionOrBosonEnum::FERMION);
-					if (savedSign != myOp.fermionOrBoson || fermionicSigns.size() == 0) {
-						utils::fillFermionicSigns(fermionicSigns,
-						                          basis2.signs(),
-						                          (isFermion) ? -1 : 1);
-						savedSign = myOp.fermionOrBoson;
-					}
-					operators_.externalProduct(i,
-					                           myOp,
-					                           basis2.size(),
-					                           fermionicSigns,
-					                           false,
-					                           apply);
 				} else {
 					operators_.externalProductReduced(i,
 					                                  basis2,
@@ -393,7 +378,10 @@ private:
 		                                          basis2.reducedHamiltonian(),
 		                                          basis3.reducedHamiltonian());
 		//! re-order operators and hamiltonian
-		operators_.reorder(BaseType::permutationVector());
+		if (this->useSu2Symmetry())
+			operators_.reorder(BaseType::permutationVector());
+		else
+			operators_.reorderHamiltonian(BaseType::permutationVector());
 
 		SizeType offset1 = basis2.operatorsPerSite_.size();
 		operatorsPerSite_.resize(offset1+basis3.operatorsPerSite_.size());
@@ -0,0 +1,222 @@
+#ifndef BLOCKDAVIDSONSOLVER_H
+#define BLOCKDAVIDSONSOLVER_H
+#include "Vector.h"
+#include "Matrix.h"
+#include "ProgressIndicator.h"
+
+namespace Dmrg {
+
+/* PSIDOC BlockDavidsonSolver
+With \verb!useBlockDavidson! in SolverOptions the lowest Excited+1
+eigenpairs of each targeted symmetry sector
+are converged together in a single subspace, that is expanded by the
+corrections of all non-converged Ritz vectors at once.
+The correction of the Ritz pair $(\theta, z)$ with residual $r$ is
+$(\theta - D)^{-1}r$, where $D$ is the diagonal of the Hamiltonian
+of the sector (Jacobi preconditioner).
+The state number Excited is then used as the ground state, as with Lanczos.
+The number of iterations is given by LanczosSteps, and
+an eigenpair is considered converged when the square of the norm of its residual
+is smaller than LanczosEps. If not all Excited+1 eigenpairs converge
+the exact diagonalization of the sector is used instead, as when Lanczos fails.
+The block is only the set of eigenpairs converged together: the Hamiltonian is
+still applied to one vector at a time, the subspace is built anew at each step
+starting from the guess of the wave function transformation for state Excited,
+and only state Excited is passed on to the targeting.
+*/
+template<typename ParametersForSolverType, typename MatrixType, typename VectorType>
+class BlockDavidsonSolver {
+
+	typedef typename VectorType::value_type ComplexOrRealType;
+	typedef typename PsimagLite::Real<ComplexOrRealType>::Type RealType;
+	typedef typename PsimagLite::Vector<VectorType>::Type VectorVectorType;
+	typedef PsimagLite::Matrix<ComplexOrRealType> MatrixComplexOrRealType;
+
+	// the subspace is restarted with the current Ritz vectors when it
+	// would grow beyond this many blocks
+	static const SizeType MAX_BLOCKS = 16;
+
+	// smallest denominator of the preconditioner
+	static RealType minDenominator() { return 1e-4; }
+
+public:
+
+	typedef typename PsimagLite::Vector<RealType>::Type VectorRealType;
+
+	BlockDavidsonSolver(const MatrixType& mat,
+	                    const VectorRealType& diagonal,
+	                    const ParametersForSolverType& params)
+	    : mat_(mat),
+	      diagonal_(diagonal),
+	      params_(params),
+	      matvecs_(0),
+	      progress_("BlockDavidsonSolver")
+	{}
+
+	void computeStates(VectorRealType& eigs,
+	                   VectorVectorType& z,
+	                   const VectorType& init,
+	                   SizeType k)
+	{
+		const SizeType n = mat_.rows();
+		if (k > n) k = n;
+		assert(k > 0);
+
+		const SizeType maxSubspace = std::min(n, MAX_BLOCKS*k);
+		VectorVectorType v;
+		VectorVectorType w;
+
+		addToBasis(v, w, init);
+		while (v.size() < k) {
+			VectorType tmp(n);
+			PsimagLite::fillRandom(tmp);
+			addToBasis(v, w, tmp);
+		}
+
+		eigs.resize(k);
+		z.resize(k);
+		VectorRealType residuals(k, 0.0);
+		VectorVectorType r(k);
+		SizeType iter = 0;
+		bool converged = false;
+		for (; iter < params_.steps; ++iter) {
+			ritz(eigs, z, r, v, w, k);
+
+			converged = true;
+			for (SizeType a = 0; a < k; ++a) {
+				residuals[a] = PsimagLite::norm(r[a]);
+				if (residuals[a]*residuals[a] >= params_.tolerance)
+					converged = false;
+			}
+
+			if (converged) break;
+
+			if (v.size() + k > maxSubspace) {
+				v = z;
+				w = r;
+				for (SizeType a = 0; a < k; ++a)
+					for (SizeType i = 0; i < n; ++i)
+						w[a][i] += eigs[a]*z[a][i];
+			}
+
+			SizeType added = 0;
+			for (SizeType a = 0; a < k; ++a) {
+				if (residuals[a]*residuals[a] < params_.tolerance) continue;
+				precondition(r[a], eigs[a]);
+				if (addToBasis(v, w, r[a])) ++added;
+			}
+
+			if (added == 0) break;
+		}
+
+		if (!converged) {
+			PsimagLite::OstringStream msg;
+			msg<<"BlockDavidsonSolver: "<<k<<" states not converged after ";
+			msg<<iter<<" iterations; residuals";
+			for (SizeType a = 0; a < k; ++a)
+				msg<<" "<<residuals[a];
+			throw PsimagLite::RuntimeError(msg.str() + "\n");
+		}
+
+		PsimagLite::OstringStream msg;
+		msg<<"Converged "<<k<<" states in "<<iter<<" iterations and ";
+		msg<<matvecs_<<" matrix vector products; eigenvalues";
+		for (SizeType a = 0; a < k; ++a)
+			msg<<" "<<eigs[a];
+		progress_.printline(msg, std::cout);
+	}
+
+	SizeType matvecs() const { return matvecs_; }
+
+private:
+
+	// Rayleigh-Ritz on the current subspace;
+	// also returns the residuals r[a] = H z[a] - eigs[a] z[a]
+	void ritz(VectorRealType& eigs,
+	          VectorVectorType& z,
+	          VectorVectorType& r,
+	          const VectorVectorType& v,
+	          const VectorVectorType& w,
+	          SizeType k) const
+	{
+		const SizeType m = v.size();
+		const SizeType n = mat_.rows();
+		MatrixComplexOrRealType t(m, m);
+		for (SizeType i = 0; i < m; ++i)
+			for (SizeType j = 0; j < m; ++j)
+				t(i, j) = scalarProduct(v[i], w[j]);
+
+		VectorRealType theta(m);
+		diag(t, theta, 'V');
+
+		for (SizeType a = 0; a < k; ++a) {
+			eigs[a] = theta[a];
+			z[a].assign(n, 0.0);
+			r[a].assign(n, 0.0);
+			for (SizeType i = 0; i < m; ++i) {
+				const ComplexOrRealType c = t(i, a);
+				for (SizeType x = 0; x < n; ++x) {
+					z[a][x] += c*v[i][x];
+					r[a][x] += c*w[i][x];
+				}
+			}
+
+			for (SizeType x = 0; x < n; ++x)
+				r[a][x] -= theta[a]*z[a][x];
+		}
+	}
+
+	// r[x] /= (theta - diagonal[x]), keeping denominators away from zero
+	void precondition(VectorType& r, RealType theta) const
+	{
+		assert(r.size() == diagonal_.size());
+		for (SizeType x = 0; x < r.size(); ++x) {
+			RealType den = theta - diagonal_[x];
+			if (fabs(den) < minDenominator())
+				den = (den < 0) ? -minDenominator() : minDenominator();
+			r[x] /= den;
+		}
+	}
+
+	// Gram-Schmidt twice against v, then normalize and push it together with
+	// its image under the matrix; returns false if vector was linearly dependent
+	bool addToBasis(VectorVectorType& v, VectorVectorType& w, const VectorType& src)
+	{
+		VectorType y = src;
+		for (SizeType times = 0; times < 2; ++times) {
+			for (SizeType i = 0; i < v.size(); ++i) {
+				const ComplexOrRealType c = scalarProduct(v[i], y);
+				for (SizeType x = 0; x < y.size(); ++x)
+					y[x] -= c*v[i][x];
+			}
+		}
+
+		RealType norma = PsimagLite::norm(y);
+		if (norma < 1e-10) return false;
+		for (SizeType x = 0; x < y.size(); ++x)
+			y[x] /= norma;
+
+		VectorType hy(y.size(), 0.0);
+		mat_.matrixVectorProduct(hy, y);
+		++matvecs_;
+		v.push_back(y);
+		w.push_back(hy);
+		return true;
+	}
+
+	static ComplexOrRealType scalarProduct(const VectorType& a, const VectorType& b)
+	{
+		ComplexOrRealType sum = 0.0;
+		for (SizeType x = 0; x < a.size(); ++x)
+			sum += PsimagLite::conj(a[x])*b[x];
+		return sum;
+	}
+
+	const MatrixType& mat_;
+	const VectorRealType& diagonal_;
+	const ParametersForSolverType& params_;
+	SizeType matvecs_;
+	PsimagLite::ProgressIndicator progress_;
+}; // class BlockDavidsonSolver
+} // namespace Dmrg
+#endif // BLOCKDAVIDSONSOLVER_H
@@ -85,6 +85,8 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 
 namespace Dmrg {
 
+// All coefficients for 2j < jmax are computed by init(), so that
+// operator() only reads and the object can be shared by threads
 template<typename FieldType>
 class ClebschGordanCached {
 	typedef ClebschGordan<FieldType> ClebschGordanType;
@@ -106,33 +108,55 @@ public:
 		jmax_=jmax;
 		max2_=((jmax_-1)*(jmax_+2))/2+1;
 		max22_=max2_*max2_;
-		data_.resize(max22_*jmax_*2,UNDEFINED_VALUE);
-		cgObject_.init(nfactorials);
-
-		copies_++;
-		if (copies_>2) {
-			std::cerr<<"WARNING: ClebschGordanCached has ";
-			std::cerr<<copies_<<" copies.\n";
-		}
+		data_.assign(max22_*jmax_*2,UNDEFINED_VALUE);
+		// precompute() needs factorials up to 2*jmax - 1
+		cgObject_.init(std::max(nfactorials, 2*jmax_));
+		precompute();
 	}
 
-	FieldType operator()(const PairType& jm,const PairType& jm1,const PairType& jm2)
+	FieldType operator()(const PairType& jm,const PairType& jm1,const PairType& jm2) const
 	{
 		if (!checkCg(jm,jm1,jm2)) return 0;
 
+		SizeType x = calcIndex(jm,jm1,jm2);
+		assert(data_[x] != UNDEFINED_VALUE);
+		return data_[x];
+	}
+
+private:
+
+	// fills every (j, j1, m1, j2, m2) that passes checkCg; m follows from the others
+	void precompute()
+	{
+		for (SizeType j1 = 0; j1 < jmax_; ++j1) {
+			for (SizeType m1 = 0; m1 <= j1; ++m1) {
+				const PairType jm1(j1, m1);
+				for (SizeType j2 = 0; j2 < jmax_; ++j2) {
+					for (SizeType m2 = 0; m2 <= j2; ++m2) {
+						const PairType jm2(j2, m2);
+						const SizeType jmin = (j1 > j2) ? j1 - j2 : j2 - j1;
+						for (SizeType j = jmin; j <= j1 + j2; j += 2) {
+							int m = calcM(j,jm1,jm2);
+							if (m < 0) continue;
+							const PairType jm(j, m);
+							data_[calcIndex(jm,jm1,jm2)] = cgObject_(jm,jm1,jm2);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	SizeType calcIndex(const PairType& jm,const PairType& jm1,const PairType& jm2) const
+	{
 		SizeType index1 = calcSubIndex(jm1);
 		SizeType index2 = calcSubIndex(jm2);
 		SizeType jmin=0;
 		if (jm1.first>jm2.first) jmin = jm1.first-jm2.first;
 		else jmin = jm2.first-jm1.first;
-		SizeType x = calcIndex(index1,index2)+(jm.first-jmin)*max22_;
-		if (data_[x]== UNDEFINED_VALUE) {
-			data_[x]=cgObject_(jm,jm1,jm2);
-		}
-		return data_[x];
+		return calcIndex(index1,index2)+(jm.first-jmin)*max22_;
 	}
 
-private:
 	SizeType calcSubIndex(const PairType& jm) const
 	{
 		if (jm.second==0) return jm.first;
@@ -181,7 +205,6 @@ private:
 		return jm1.second+jm2.second-x;
 	}
 
-	static SizeType copies_;
 	int UNDEFINED_VALUE;
 	SizeType jmax_;
 	SizeType max2_,max22_;
@@ -189,9 +212,6 @@ private:
 	ClebschGordanType cgObject_;
 }; // class ClebschGordanCached
 
-template<typename FieldType>
-SizeType ClebschGordanCached<FieldType>::copies_=0;
-
 } // namespace Dmrg
 /*@}*/
 #endif
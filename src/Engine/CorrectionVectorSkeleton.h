@@ -225,6 +225,7 @@ public:
 	TridiagRixsStaticType;
 	typedef typename ParallelTriDiagType::MatrixComplexOrRealType MatrixComplexOrRealType;
 	typedef typename ParallelTriDiagType::VectorMatrixFieldType VectorMatrixFieldType;
+	typedef typename ParallelTriDiagType::LanczosMatrixCacheType LanczosMatrixCacheType;
 	typedef PsimagLite::Vector<SizeType>::Type VectorSizeType;
 	typedef typename PsimagLite::Vector<VectorRealType>::Type VectorVectorRealType;
 	typedef typename ModelType::InputValidatorType InputValidatorType;
@@ -233,11 +234,13 @@ public:
 	                         const TargetParamsType& tstStruct,
 	                         const ModelType& model,
 	                         const LeftRightSuperType& lrs,
+	                         const LanczosMatrixCacheType& lanczosMatrices,
 	                         const RealType& energy)
 	    : ioIn_(ioIn),
 	      tstStruct_(tstStruct),
 	      model_(model),
 	      lrs_(lrs),
+	      lanczosMatrices_(lanczosMatrices),
 	      energy_(energy),
 	      progress_("CorrectionVectorSkeleton")
 	{}
@@ -308,13 +311,8 @@ public:
 			throw PsimagLite::RuntimeError("Matsubara only with KRYLOV\n");
 
 		RealType fakeTime = 0;
-		typename ModelType::HamiltonianConnectionType hc(p,
-		                                                 lrs_,
-		                                                 model_.geometry(),
-		                                                 ModelType::modelLinks(),
-		                                                 fakeTime,
-		                                                 0);
-		LanczosMatrixType h(model_, hc);
+		const typename LanczosMatrixCacheType::BuiltPtrType built = lanczosMatrices_(p, fakeTime);
+		const LanczosMatrixType& h = built->matrix();
 		RealType E0 = energy_;
 		CorrectionVectorFunctionType cvft(h,tstStruct_,E0);
 
@@ -428,7 +426,7 @@ public:
 		                                  steps,
 		                                  lrs_,
 		                                  fakeTime,
-		                                  model_,
+		                                  lanczosMatrices_,
 		                                  ioIn_);
 
 		threadedTriDiag.loopCreate(helperTriDiag);
@@ -458,6 +456,7 @@ private:
 	const TargetParamsType& tstStruct_;
 	const ModelType& model_;
 	const LeftRightSuperType& lrs_;
+	const LanczosMatrixCacheType& lanczosMatrices_;
 	const RealType& energy_;
 	PsimagLite::ProgressIndicator progress_;
 	RealType weightForContinuedFraction_;
@@ -85,6 +85,8 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include "CrsMatrix.h"
 #include "ApplyOperatorLocal.h"
 #include "Braket.h"
+#include "Parallelizer.h"
+#include "SectorChunks.h"
 #include <numeric>
 
 namespace Dmrg {
@@ -101,6 +103,7 @@ public:
 	typedef typename VectorWithOffsetType::VectorType VectorType ;
 	typedef typename ObserverHelperType::BasisWithOperatorsType BasisWithOperatorsType;
 	typedef typename ObserverHelperType::FermionSignType FermionSignType;
+	typedef typename ObserverHelperType::StepPin StepPinType;
 	typedef typename BasisWithOperatorsType::RealType RealType;
 	typedef typename BasisWithOperatorsType::BasisType BasisType;
 	typedef typename BasisType::VectorSizeType VectorSizeType;
@@ -110,8 +113,23 @@ public:
 
 	enum class GrowDirection {RIGHT, LEFT};
 
-	CorrelationsSkeleton(const ObserverHelperType& helper, bool normalizeResult)
-	    : helper_(helper), normalizeResult_(normalizeResult)
+	// threads is the number of threads a bracket may use; give 1 to a
+	// skeleton whose brackets run inside an outer parallel loop
+	CorrelationsSkeleton(const ObserverHelperType& helper,
+	                     bool normalizeResult,
+	                     SizeType threads)
+	    : helper_(helper),
+	      normalizeResult_(normalizeResult),
+	      threads_(threads),
+	      parallelizer_(PsimagLite::CodeSectionParams(threads))
+	{}
+
+	// the skeleton of other, with brackets using threads threads
+	CorrelationsSkeleton(const CorrelationsSkeleton& other, SizeType threads)
+	    : helper_(other.helper_),
+	      normalizeResult_(other.normalizeResult_),
+	      threads_(threads),
+	      parallelizer_(PsimagLite::CodeSectionParams(threads))
 	{}
 
 	SizeType numberOfSites() const
@@ -176,6 +194,7 @@ public:
 	             bool transform,
 	             SizeType ptr) const
 	{
+		StepPinType pin(helper_, ptr);
 		const int fermionicSign = (fOrB == ProgramGlobals::FermionOrBosonEnum::BOSON) ? 1 : -1;
 		const ProgramGlobals::DirectionEnum dir = helper_.direction(ptr);
 
@@ -261,6 +280,7 @@ public:
 	                      SizeType ns) const
 	{
 		SizeType ptr = (ns == 0) ? ns : ns - 1;
+		StepPinType pin(helper_, ptr);
 		if (helper_.direction(ptr) == ProgramGlobals::DirectionEnum::EXPAND_SYSTEM)
 			dmrgMultiplySystem(result, ptr, O1, O2, fermionicSign, ns);
 		else
@@ -287,6 +307,7 @@ public:
 	                  PsimagLite::String ket) const
 	{
 		try {
+			StepPinType pin(helper_, ptr);
 			const VectorWithOffsetType& src1 = helper_.getVectorFromBracketId(bra, ptr);
 			const VectorWithOffsetType& src2 = helper_.getVectorFromBracketId(ket, ptr);
 
@@ -307,6 +328,7 @@ public:
 	                             PsimagLite::String ket) const
 	{
 		try {
+			StepPinType pin(helper_, ptr);
 			const VectorWithOffsetType& src1 = helper_.getVectorFromBracketId(bra, ptr);
 			const VectorWithOffsetType& src2 = helper_.getVectorFromBracketId(ket, ptr);
 			return bracketRightCorner_(A,B,fermionSign,src1,src2,ptr);
@@ -327,6 +349,7 @@ public:
 	                             PsimagLite::String ket) const
 	{
 		try {
+			StepPinType pin(helper_, ptr);
 			const VectorWithOffsetType& src1 = helper_.getVectorFromBracketId(bra, ptr);
 			const VectorWithOffsetType& src2 = helper_.getVectorFromBracketId(ket, ptr);
 			return bracketRightCorner_(A,B,C,fermionSign,src1,src2,ptr);
@@ -342,15 +365,81 @@ public:
 
 private:
 
+	enum class BracketEnum {SYSTEM,
+	                        ENVIRON,
+	                        RIGHT_CORNER_SYSTEM,
+	                        LEFT_CORNER_ENVIRON,
+	                        RIGHT_CORNER_ABC};
+
+	// what a bracket needs, see bracketChunk
+	struct BracketArgs {
+
+		template<typename LeftRightSuperType>
+		BracketArgs(BracketEnum kind_,
+		            const VectorWithOffsetType& vec1_,
+		            const VectorWithOffsetType& vec2_,
+		            const LeftRightSuperType& lrs)
+		    : kind(kind_),
+		      vec1(vec1_),
+		      vec2(vec2_),
+		      left(lrs.left()),
+		      right(lrs.right()),
+		      superPerm(lrs.super().permutationVector()),
+		      superPermInverse(lrs.super().permutationInverse()),
+		      A(0),
+		      B(0),
+		      C(0),
+		      ni(0),
+		      isFermion(false),
+		      signRight(1),
+		      fermionSign(1)
+		{}
+
+		BracketEnum kind;
+		const VectorWithOffsetType& vec1;
+		const VectorWithOffsetType& vec2;
+		const BasisWithOperatorsType& left;
+		const BasisWithOperatorsType& right;
+		const VectorSizeType& superPerm;
+		const VectorSizeType& superPermInverse;
+		const SparseMatrixType* A;
+		const SparseMatrixType* B;
+		const SparseMatrixType* C;
+		SizeType ni;
+		bool isFermion;
+		int signRight;
+		int fermionSign;
+	};
+
+	class ParallelBracket {
+
+	public:
+
+		ParallelBracket(const CorrelationsSkeleton& skeleton,
+		                const BracketArgs& args,
+		                const SectorChunks& chunks,
+		                typename PsimagLite::Vector<FieldType>::Type& sums)
+		    : skeleton_(skeleton), args_(args), chunks_(chunks), sums_(sums)
+		{}
+
+		void doTask(SizeType taskNumber, SizeType)
+		{
+			sums_[taskNumber] = skeleton_.bracketChunk(args_, chunks_[taskNumber]);
+		}
+
+		SizeType tasks() const { return chunks_.size(); }
+
+	private:
+
+		const CorrelationsSkeleton& skeleton_;
+		const BracketArgs& args_;
+		const SectorChunks& chunks_;
+		typename PsimagLite::Vector<FieldType>::Type& sums_;
+	};
+
 	int fermionSignBasis(int fermionicSign, const BasisType& basis) const
 	{
-		const typename BasisWithOperatorsType::VectorBoolType& v = basis.signs();
-		SizeType n = v.size();
-		if (n == 0) return 1;
-		bool nx0 = v[0];
-		for (SizeType i = 1; i < n; ++i)
-			nx0 ^= v[i];
-		return (nx0) ? fermionicSign : 1;
+		return (basis.oddNumberOfOddStates()) ? fermionicSign : 1;
 	}
 
 	void dmrgMultiplySystem(SparseMatrixType& result,
@@ -515,29 +604,9 @@ private:
 	                         const VectorWithOffsetType& vec2,
 	                         SizeType ptr) const
 	{
-		FieldType sum=0;
-		PackIndicesType pack(helper_.leftRightSuper(ptr).left().size());
-		for (SizeType x=0;x<vec1.sectors();x++) {
-			SizeType sector = vec1.sector(x);
-			SizeType offset = vec1.offset(sector);
-			SizeType total = offset + vec1.effectiveSize(sector);
-			for (SizeType t=offset;t<total;t++) {
-				SizeType eta,r;
-
-				pack.unpack(r,eta,helper_.leftRightSuper(ptr).super().
-				            permutation(t));
-				for (int k=A.getRowPtr(r);k<A.getRowPtr(r+1);k++) {
-					SizeType r2 = A.getCol(k);
-					SizeType t2 = helper_.leftRightSuper(ptr).super().
-					        permutationInverse(r2+eta*A.cols());
-					if (t2<offset || t2>=total) continue;
-					sum += A.getValue(k)*PsimagLite::conj(vec1.slowAccess(t))*
-					        vec2.slowAccess(t2);
-				}
-			}
-		}
-
-		return resultDivided(sum,vec1);
+		BracketArgs args(BracketEnum::SYSTEM, vec1, vec2, helper_.leftRightSuper(ptr));
+		args.A = &A;
+		return resultDivided(sumOverSectors(args),vec1);
 	}
 
 	FieldType bracketEnviron_(const SparseMatrixType& A,
@@ -551,33 +620,9 @@ private:
 		RealType sign = fermionSignBasis(fermionicSign,
 		                                 helper_.leftRightSuper(ptr).left());
 
-		FieldType sum=0;
-		PackIndicesType pack(helper_.leftRightSuper(ptr).left().size());
-		SizeType leftSize = helper_.leftRightSuper(ptr).left().size();
-
-		for (SizeType x=0;x<vec1.sectors();x++) {
-			SizeType sector = vec1.sector(x);
-			SizeType offset = vec1.offset(sector);
-			SizeType total = offset + vec1.effectiveSize(sector);
-			for (SizeType t=offset;t<total;t++) {
-				SizeType eta,r;
-
-				pack.unpack(r,eta,helper_.leftRightSuper(ptr).super().
-				            permutation(t));
-				if (eta>=A.rows()) throw PsimagLite::RuntimeError("Error\n");
-
-				for (int k=A.getRowPtr(eta);k<A.getRowPtr(eta+1);k++) {
-					SizeType eta2 = A.getCol(k);
-					SizeType t2 = helper_.leftRightSuper(ptr).super().
-					        permutationInverse(r+eta2*leftSize);
-					if (t2<offset || t2>=total) continue;
-					sum += A.getValue(k)*PsimagLite::conj(vec1.slowAccess(t))*
-					        vec2.slowAccess(t2)*sign;
-				}
-			}
-		}
-
-		return resultDivided(sum,vec1);
+		BracketArgs args(BracketEnum::ENVIRON, vec1, vec2, helper_.leftRightSuper(ptr));
+		args.A = &A;
+		return resultDivided(sumOverSectors(args)*sign,vec1);
 	}
 
 	FieldType bracketRightCorner_(const SparseMatrixType& A,
@@ -592,15 +637,6 @@ private:
 		        : brLftCrnrEnviron_(A,B,fermionSign,vec1,vec2,ptr);
 	}
 
-	bool superOddElectrons(SizeType t, SizeType ptr) const
-	{
-		// return helper_.leftRightSuper(ptr).super().electrons(t);
-		SizeType tmp = helper_.leftRightSuper(ptr).super().permutation(t);
-		div_t mydiv = PsimagLite::div(tmp,helper_.leftRightSuper(ptr).left().size());
-		return helper_.leftRightSuper(ptr).right().signs()[mydiv.quot] ^
-		        helper_.leftRightSuper(ptr).left().signs()[mydiv.rem];
-	}
-
 	FieldType brRghtCrnrSystem_(const SparseMatrixType& Acrs,
 	                            const SparseMatrixType& Bcrs,
 	                            ProgramGlobals::FermionOrBosonEnum fermionSign,
@@ -608,8 +644,6 @@ private:
 	                            const VectorWithOffsetType& vec2,
 	                            SizeType ptr) const
 	{
-		FieldType sum = 0;
-		SizeType leftSize = helper_.leftRightSuper(ptr).left().size();
 		SizeType ni = helper_.leftRightSuper(ptr).left().size()/Bcrs.rows();
 
 		// some sanity checks:
@@ -621,45 +655,15 @@ private:
 			err("Observe::brRghtCrnrSystem_(...)\n");
 
 		// ok, we're ready for the main course:
-		PackIndicesType pack1(helper_.leftRightSuper(ptr).left().size());
-		PackIndicesType pack2(ni);
-		for (SizeType x=0;x<vec1.sectors();x++) {
-			SizeType sector = vec1.sector(x);
-			SizeType offset = vec1.offset(sector);
-			SizeType total = offset + vec1.effectiveSize(sector);
-			for (SizeType t=offset;t<total;t++) {
-				SizeType eta,r;
-
-				pack1.unpack(r,eta,helper_.leftRightSuper(ptr).super().
-				             permutation(t));
-				SizeType r0,r1;
-				pack2.unpack(r0,r1,helper_.leftRightSuper(ptr).left().
-				             permutation(r));
-				bool odd = superOddElectrons(t,ptr);
-				odd ^= helper_.leftRightSuper(ptr).right().signs()[eta];
-				const RealType sign = (odd && fermionSign ==
-				                       ProgramGlobals::FermionOrBosonEnum::FERMION) ? -1.0
-				                                                                    : 1.0;
-
-				for (int k=Acrs.getRowPtr(r0);k<Acrs.getRowPtr(r0+1);k++) {
-					SizeType r0prime = Acrs.getCol(k);
-					for (int k2 = Bcrs.getRowPtr(eta);
-					     k2<Bcrs.getRowPtr(eta+1);k2++) {
-						SizeType eta2 = Bcrs.getCol(k2);
-						SizeType rprime = helper_.leftRightSuper(ptr).left().
-						        permutationInverse(r0prime+r1*ni);
-						SizeType t2 = helper_.leftRightSuper(ptr).super().
-						        permutationInverse(rprime+eta2*leftSize);
-						if (t2<offset || t2>=total) continue;
-						sum += Acrs.getValue(k)*Bcrs.getValue(k2)*
-						        PsimagLite::conj(vec1.slowAccess(t))*
-						        vec2.slowAccess(t2)*sign;
-					}
-				}
-			}
-		}
-
-		return resultDivided(sum,vec1);
+		BracketArgs args(BracketEnum::RIGHT_CORNER_SYSTEM,
+		                 vec1,
+		                 vec2,
+		                 helper_.leftRightSuper(ptr));
+		args.A = &Acrs;
+		args.B = &Bcrs;
+		args.ni = ni;
+		args.isFermion = (fermionSign == ProgramGlobals::FermionOrBosonEnum::FERMION);
+		return resultDivided(sumOverSectors(args),vec1);
 	}
 
 	FieldType brLftCrnrEnviron_(const SparseMatrixType& Acrs,
@@ -672,9 +676,6 @@ private:
 		const int fermionSign = (fOrB == ProgramGlobals::FermionOrBosonEnum::BOSON) ? 1 : -1;
 		int signRight = fermionSignBasis(fermionSign,
 		                                 helper_.leftRightSuper(ptr).right());
-		FieldType sum = 0;
-		SizeType ni = Bcrs.rows();
-		SizeType leftSize = helper_.leftRightSuper(ptr).left().size();
 
 		// some sanity checks:
 		if (vec1.size() != vec2.size() ||
@@ -684,42 +685,16 @@ private:
 			err("Observe::brLftCrnrEnviron_(...)\n");
 
 		// ok, we're ready for the main course:
-		PackIndicesType pack1(helper_.leftRightSuper(ptr).left().size());
-		PackIndicesType pack2(ni);
-
-		for (SizeType x=0;x<vec1.sectors();x++) {
-			SizeType sector = vec1.sector(x);
-			SizeType offset = vec1.offset(sector);
-			SizeType total = offset + vec1.effectiveSize(sector);
-			for (SizeType t=offset;t<total;t++) {
-				SizeType eta,r;
-
-				pack1.unpack(eta,r,helper_.leftRightSuper(ptr).super().
-				             permutation(t));
-				SizeType r0,r1;
-				pack2.unpack(r0,r1,helper_.leftRightSuper(ptr).right().permutation(r));
-				const RealType sign = (fOrB == ProgramGlobals::FermionOrBosonEnum::BOSON)
-				        ? 1 : helper_.signsOneSite(r0) * signRight;
-
-				for (int k=Acrs.getRowPtr(r1);k<Acrs.getRowPtr(r1+1);k++) {
-					SizeType r1prime = Acrs.getCol(k);
-					for (int k2 = Bcrs.getRowPtr(eta);
-					     k2<Bcrs.getRowPtr(eta+1);k2++) {
-						SizeType eta2 = Bcrs.getCol(k2);
-						SizeType rprime = helper_.leftRightSuper(ptr).right().
-						        permutationInverse(r0+r1prime*ni);
-						SizeType t2 = helper_.leftRightSuper(ptr).super().
-						        permutationInverse(eta2+rprime*leftSize);
-						if (t2<offset || t2>=total) continue;
-						sum += PsimagLite::conj(Acrs.getValue(k))*Bcrs.getValue(k2)*
-						        PsimagLite::conj(vec1.slowAccess(t))*
-						        vec2.slowAccess(t2)*sign;
-					}
-				}
-			}
-		}
-
-		return resultDivided(sum,vec1);
+		BracketArgs args(BracketEnum::LEFT_CORNER_ENVIRON,
+		                 vec1,
+		                 vec2,
+		                 helper_.leftRightSuper(ptr));
+		args.A = &Acrs;
+		args.B = &Bcrs;
+		args.ni = Bcrs.rows();
+		args.isFermion = (fOrB == ProgramGlobals::FermionOrBosonEnum::FERMION);
+		args.signRight = signRight;
+		return resultDivided(sumOverSectors(args),vec1);
 	}
 
 	FieldType bracketRightCorner_(const SparseMatrixType& A1,
@@ -733,14 +708,7 @@ private:
 		if (helper_.direction(ptr) != ProgramGlobals::DirectionEnum::EXPAND_SYSTEM)
 			return 0;
 
-		const int fermionSign = (fOrB == ProgramGlobals::FermionOrBosonEnum::BOSON) ? 1 : -1;
-
-		SparseMatrixType A1crs(A1);
-		SparseMatrixType A2crs(A2);
-		SparseMatrixType Bcrs(B);
-		FieldType sum=0;
-		SizeType ni = helper_.leftRightSuper(ptr).left().size()/Bcrs.rows();
-		SizeType leftSize = helper_.leftRightSuper(ptr).left().size();
+		SizeType ni = helper_.leftRightSuper(ptr).left().size()/B.rows();
 
 		// some sanity checks:
 		assert(vec1.size()==vec2.size());
@@ -748,52 +716,170 @@ private:
 		if (vec1.size()==0) return 0;
 
 		assert(vec1.size()==helper_.leftRightSuper(ptr).super().size());
-		assert(ni==A1crs.rows());
-		assert(Bcrs.rows()==A2crs.rows());
+		assert(ni==A1.rows());
+		assert(B.rows()==A2.rows());
 
 		// ok, we're ready for the main course:
-		PackIndicesType pack1(helper_.leftRightSuper(ptr).left().size());
-		PackIndicesType pack2(ni);
-
-		for (SizeType x=0;x<vec1.sectors();x++) {
-			SizeType sector = vec1.sector(x);
-			SizeType offset = vec1.offset(sector);
-			SizeType total = offset + vec1.effectiveSize(sector);
-			for (SizeType t=offset;t<total;t++) {
-				SizeType eta,r;
-
-				pack1.unpack(r,
-				             eta,
-				             helper_.leftRightSuper(ptr).super().permutation(t));
-				SizeType r0,r1;
-				pack2.unpack(r0,
-				             r1,
-				             helper_.leftRightSuper(ptr).left().permutation(r));
-				RealType sign = helper_.leftRightSuper(ptr).right().
-				        fermionicSign(r1,fermionSign);
-
-				for (int k1=A1crs.getRowPtr(r0);k1<A1crs.getRowPtr(r0+1);k1++) {
-					SizeType r0prime = A1crs.getCol(k1);
-					for (int k2=A2crs.getRowPtr(r1);k2<A2crs.getRowPtr(r1+1);k2++) {
-						SizeType r1prime = A2crs.getCol(k2);
-						for (int k3 = Bcrs.getRowPtr(eta);k3<Bcrs.getRowPtr(eta+1);k3++) {
-							SizeType eta2 = Bcrs.getCol(k3);
-							SizeType rprime = helper_.leftRightSuper(ptr).left().
-							        permutationInverse(r0prime+r1prime*ni);
-							SizeType t2 = helper_.leftRightSuper(ptr).super().
-							        permutationInverse(rprime+eta2*leftSize);
-							if (t2<offset || t2>=total) continue;
-							sum +=  A1crs.getValue(k1)*A2crs.getValue(k2)*
-							        Bcrs.getValue(k3)*
-							        PsimagLite::conj(vec1.slowAccess(t))*
-							        vec2.slowAccess(t2)*sign;
+		BracketArgs args(BracketEnum::RIGHT_CORNER_ABC,
+		                 vec1,
+		                 vec2,
+		                 helper_.leftRightSuper(ptr));
+		args.A = &A1;
+		args.B = &A2;
+		args.C = &B;
+		args.ni = ni;
+		args.fermionSign = (fOrB == ProgramGlobals::FermionOrBosonEnum::BOSON) ? 1 : -1;
+		return resultDivided(sumOverSectors(args),vec1);
+	}
+
+	// Sums the bracket of args over the states of the sectors of vec1 that are
+	// also sectors of vec2, split in chunks of rows of each sector, see SectorChunks.
+	// A sector of the superblock is a union of blocks of left times right
+	// states, but the operators are sparse, so the loop over the nonzeros of
+	// each row is the product of each block, with the permutations of the
+	// superblock giving the block and the position in it
+	FieldType sumOverSectors(const BracketArgs& args) const
+	{
+		const VectorWithOffsetType& vec1 = args.vec1;
+		const VectorWithOffsetType& vec2 = args.vec2;
+
+		SectorChunks chunks(threads_);
+		for (SizeType x = 0; x < vec1.sectors(); ++x) {
+			const SizeType sector = vec1.sector(x);
+			const SizeType offset = vec1.offset(sector);
+			const SizeType total = vec1.effectiveSize(sector);
+			if (total == 0 || vec2.index2Sector(offset) != static_cast<int>(sector))
+				continue;
+
+			chunks.push(sector, offset, offset + total);
+		}
+
+		typename PsimagLite::Vector<FieldType>::Type sums(chunks.size(), 0.0);
+		ParallelBracket helperBracket(*this, args, chunks, sums);
+		chunks.loop(helperBracket, parallelizer_);
+
+		// in order, so that the sum does not depend on the number of threads
+		FieldType sum = 0;
+		for (SizeType i = 0; i < sums.size(); ++i)
+			sum += sums[i];
+
+		return sum;
+	}
+
+	// the bracket of args over states task.start to task.end of sector task.sector
+	FieldType bracketChunk(const BracketArgs& args, const SectorChunks::Chunk& task) const
+	{
+		const VectorSizeType& superPerm = args.superPerm;
+		const VectorSizeType& superPermInverse = args.superPermInverse;
+		const VectorSizeType& leftPerm = args.left.permutationVector();
+		const VectorSizeType& leftPermInverse = args.left.permutationInverse();
+		const VectorSizeType& rightPerm = args.right.permutationVector();
+		const VectorSizeType& rightPermInverse = args.right.permutationInverse();
+		const SizeType leftSize = args.left.size();
+		const SizeType sector = task.sector;
+		const SizeType offset = args.vec1.offset(sector);
+		const SizeType total = offset + args.vec1.effectiveSize(sector);
+		const SparseMatrixType& A = *args.A;
+		const SizeType ni = args.ni;
+
+		FieldType sum = 0;
+		for (SizeType t = task.start; t < task.end; ++t) {
+			const FieldType v1 = PsimagLite::conj(args.vec1.fastAccess(sector, t - offset));
+			if (v1 == static_cast<FieldType>(0.0)) continue;
+
+			const SizeType p = superPerm[t];
+			switch (args.kind) {
+			case BracketEnum::SYSTEM: {
+				const SizeType r = p % leftSize;
+				const SizeType eta = p/leftSize;
+				for (int k = A.getRowPtr(r); k < A.getRowPtr(r + 1); ++k) {
+					const SizeType t2 = superPermInverse[A.getCol(k) + eta*A.cols()];
+					if (t2 < offset || t2 >= total) continue;
+					sum += A.getValue(k)*v1*args.vec2.fastAccess(sector, t2 - offset);
+				}
+			}
+				break;
+			case BracketEnum::ENVIRON: {
+				const SizeType r = p % leftSize;
+				const SizeType eta = p/leftSize;
+				if (eta >= A.rows()) throw PsimagLite::RuntimeError("Error\n");
+
+				for (int k = A.getRowPtr(eta); k < A.getRowPtr(eta + 1); ++k) {
+					const SizeType t2 = superPermInverse[r + A.getCol(k)*leftSize];
+					if (t2 < offset || t2 >= total) continue;
+					sum += A.getValue(k)*v1*args.vec2.fastAccess(sector, t2 - offset);
+				}
+			}
+				break;
+			case BracketEnum::RIGHT_CORNER_SYSTEM: {
+				const SparseMatrixType& B = *args.B;
+				const SizeType r = p % leftSize;
+				const SizeType eta = p/leftSize;
+				const SizeType r0 = leftPerm[r] % ni;
+				const SizeType r1 = leftPerm[r]/ni;
+				// electrons of the super state but those of eta: those of r
+				const bool odd = args.left.signs()[r];
+				const RealType sign = (odd && args.isFermion) ? -1.0 : 1.0;
+
+				for (int k = A.getRowPtr(r0); k < A.getRowPtr(r0 + 1); ++k) {
+					const SizeType rprime = leftPermInverse[A.getCol(k) + r1*ni];
+					for (int k2 = B.getRowPtr(eta); k2 < B.getRowPtr(eta + 1); ++k2) {
+						const SizeType t2 = superPermInverse[rprime + B.getCol(k2)*leftSize];
+						if (t2 < offset || t2 >= total) continue;
+						sum += A.getValue(k)*B.getValue(k2)*v1*
+						        args.vec2.fastAccess(sector, t2 - offset)*sign;
+					}
+				}
+			}
+				break;
+			case BracketEnum::LEFT_CORNER_ENVIRON: {
+				const SparseMatrixType& B = *args.B;
+				const SizeType eta = p % leftSize;
+				const SizeType r = p/leftSize;
+				const SizeType r0 = rightPerm[r] % ni;
+				const SizeType r1 = rightPerm[r]/ni;
+				const RealType sign = (!args.isFermion)
+				        ? 1 : helper_.signsOneSite(r0)*args.signRight;
+
+				for (int k = A.getRowPtr(r1); k < A.getRowPtr(r1 + 1); ++k) {
+					const SizeType rprime = rightPermInverse[r0 + A.getCol(k)*ni];
+					for (int k2 = B.getRowPtr(eta); k2 < B.getRowPtr(eta + 1); ++k2) {
+						const SizeType t2 = superPermInverse[B.getCol(k2) + rprime*leftSize];
+						if (t2 < offset || t2 >= total) continue;
+						sum += PsimagLite::conj(A.getValue(k))*B.getValue(k2)*v1*
+						        args.vec2.fastAccess(sector, t2 - offset)*sign;
+					}
+				}
+			}
+				break;
+			case BracketEnum::RIGHT_CORNER_ABC: {
+				const SparseMatrixType& A2 = *args.B;
+				const SparseMatrixType& B = *args.C;
+				const SizeType r = p % leftSize;
+				const SizeType eta = p/leftSize;
+				const SizeType r0 = leftPerm[r] % ni;
+				const SizeType r1 = leftPerm[r]/ni;
+				const RealType sign = args.right.fermionicSign(r1, args.fermionSign);
+
+				for (int k1 = A.getRowPtr(r0); k1 < A.getRowPtr(r0 + 1); ++k1) {
+					const SizeType r0prime = A.getCol(k1);
+					for (int k2 = A2.getRowPtr(r1); k2 < A2.getRowPtr(r1 + 1); ++k2) {
+						const SizeType rprime = leftPermInverse[r0prime + A2.getCol(k2)*ni];
+						const FieldType a12 = A.getValue(k1)*A2.getValue(k2);
+						for (int k3 = B.getRowPtr(eta); k3 < B.getRowPtr(eta + 1); ++k3) {
+							const SizeType t2 = superPermInverse[rprime + B.getCol(k3)*leftSize];
+							if (t2 < offset || t2 >= total) continue;
+							sum += a12*B.getValue(k3)*v1*
+							        args.vec2.fastAccess(sector, t2 - offset)*sign;
 						}
 					}
 				}
 			}
+				break;
+			}
 		}
 
-		return resultDivided(sum,vec1);
+		return sum;
 	}
 
 	FieldType resultDivided(FieldType sum, const VectorWithOffsetType& vec) const
@@ -806,8 +892,14 @@ private:
 		return sum/norma2;
 	}
 
+	CorrelationsSkeleton(const CorrelationsSkeleton&);
+
+	CorrelationsSkeleton& operator=(const CorrelationsSkeleton&);
+
 	const ObserverHelperType& helper_;
 	bool normalizeResult_;
+	SizeType threads_;
+	mutable PsimagLite::Parallelizer<ParallelBracket> parallelizer_;
 };  //class CorrelationsSkeleton
 } // namespace Dmrg
 
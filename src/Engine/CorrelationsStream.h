@@ -0,0 +1,126 @@
+#ifndef CORRELATIONSSTREAM_H
+#define CORRELATIONSSTREAM_H
+#include "Vector.h"
+#include "Matrix.h"
+#include "PsimagLite.h"
+#include <fstream>
+#include <sstream>
+#include <map>
+
+namespace Dmrg {
+
+/* PSIDOC CorrelationsStream
+With \verb!observeStream! in SolverOptions the observe driver writes
+two-point correlation matrices to a file named like OutputFile= but ending
+in Correlations.txt, instead of printing them at the end.
+Rows are computed a few at a time (as many as threads), and each row
+is written and flushed as soon as it is done, so memory stays bounded by that
+buffer. Each line has the braket and its time, the row, the number of
+columns and the values of all columns, separated by tabs; entries below
+the diagonal are zero, as when printing. If the file exists, rows already in it are skipped,
+so that an interrupted observe run can be restarted.
+*/
+template<typename FieldType>
+class CorrelationsStream {
+
+	typedef PsimagLite::Vector<bool>::Type VectorBoolType;
+	typedef PsimagLite::Vector<PsimagLite::String>::Type VectorStringType;
+	typedef std::map<PsimagLite::String, VectorBoolType> MapType;
+
+public:
+
+	typedef PsimagLite::Matrix<FieldType> MatrixType;
+
+	CorrelationsStream(PsimagLite::String filename, bool enabled)
+	    : enabled_(enabled)
+	{
+		if (!enabled_) return;
+
+		size_t lastindex = filename.find_last_of(".");
+		filename_ = filename.substr(0, lastindex) + "Correlations.txt";
+		const bool endsInNewline = readDone();
+
+		fout_.open(filename_.c_str(), std::ios::app);
+		if (!fout_ || !fout_.good())
+			err("CorrelationsStream: cannot open " + filename_ + "\n");
+
+		if (!endsInNewline) fout_<<"\n";
+
+		fout_.precision(std::cout.precision());
+	}
+
+	bool enabled() const { return enabled_; }
+
+	const PsimagLite::String& filename() const { return filename_; }
+
+	bool hasRow(PsimagLite::String label, SizeType row) const
+	{
+		typename MapType::const_iterator it = done_.find(label);
+		if (it == done_.end()) return false;
+		return (row < it->second.size() && it->second[row]);
+	}
+
+	// writes rows offset, offset + 1, ... held in buffer
+	void write(PsimagLite::String label, const MatrixType& buffer, SizeType offset)
+	{
+		VectorBoolType& done = done_[label];
+		for (SizeType i = 0; i < buffer.n_row(); ++i) {
+			const SizeType row = offset + i;
+			fout_<<label<<"\t"<<row<<"\t"<<buffer.n_col()<<"\t";
+			for (SizeType j = 0; j < buffer.n_col(); ++j) {
+				if (j > 0) fout_<<" ";
+				fout_<<buffer(i, j);
+			}
+
+			fout_<<"\n";
+
+			if (done.size() <= row) done.resize(row + 1, false);
+			done[row] = true;
+		}
+
+		fout_.flush();
+	}
+
+private:
+
+	// a row is done only if its line has all its values and ends in a newline;
+	// a line cut by an interrupted write is ignored.
+	// Returns false if the file does not end in a newline
+	bool readDone()
+	{
+		std::ifstream fin(filename_.c_str());
+		if (!fin || !fin.good()) return true;
+
+		bool endsInNewline = true;
+		PsimagLite::String line;
+		while (std::getline(fin, line)) {
+			endsInNewline = !fin.eof();
+			if (!endsInNewline) continue;
+
+			VectorStringType fields;
+			PsimagLite::split(fields, line, "\t");
+			if (fields.size() != 4) continue;
+
+			VectorStringType values;
+			PsimagLite::split(values, fields[3], " ");
+			SizeType row = 0;
+			SizeType cols = 0;
+			std::istringstream(fields[1])>>row;
+			std::istringstream(fields[2])>>cols;
+			if (values.size() != cols) continue;
+
+			VectorBoolType& done = done_[fields[0]];
+			if (done.size() <= row) done.resize(row + 1, false);
+			done[row] = true;
+		}
+
+		return endsInNewline;
+	}
+
+	bool enabled_;
+	PsimagLite::String filename_;
+	std::ofstream fout_;
+	MapType done_;
+}; // class CorrelationsStream
+} // namespace Dmrg
+#endif // CORRELATIONSSTREAM_H
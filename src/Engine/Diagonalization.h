@@ -84,6 +84,7 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include "LanczosSolver.h"
 #include "DavidsonSolver.h"
 #include "ParametersForSolver.h"
+#include "BlockDavidsonSolver.h"
 #include "Concurrency.h"
 #include "Profiling.h"
 
@@ -113,6 +114,7 @@ public:
 	typedef typename LeftRightSuperType::ParamsForKroneckerDumperType ParamsForKroneckerDumperType;
 	typedef typename ModelType::ReflectionSymmetryType ReflectionSymmetryType;
 	typedef typename TargetingType::MatrixVectorType MatrixVectorType;
+	typedef typename TargetingType::LanczosMatrixCacheType LanczosMatrixCacheType;
 	typedef typename ModelType::InputValidatorType InputValidatorType;
 	typedef typename PsimagLite::Vector<RealType>::Type VectorRealType;
 	typedef typename PsimagLite::Vector<SizeType>::Type VectorSizeType;
@@ -126,6 +128,9 @@ public:
 	typedef PsimagLite::LanczosSolver<ParametersForSolverType,
 	MatrixVectorType,
 	TargetVectorType> LanczosSolverType;
+	typedef BlockDavidsonSolver<ParametersForSolverType,
+	MatrixVectorType,
+	TargetVectorType> BlockDavidsonSolverType;
 
 	Diagonalization(const ParametersType& parameters,
 	                const ModelType& model,
@@ -143,7 +148,15 @@ public:
 	      progress_("Diag."),
 	      quantumSector_(quantumSector),
 	      wft_(waveFunctionTransformation),
-	      oldEnergy_(oldEnergy)
+	      oldEnergy_(oldEnergy),
+	      truncationError_(-1.0),
+	      energyChange_(1.0),
+	      energyOfPreviousLoop_(0.0),
+	      lastLoopIndex_(0),
+	      loopEnds_(0),
+	      solverSteps_(0),
+	      flops_(0),
+	      wftTime_(0, 0)
 	{}
 
 	//!PTEX_LABEL{Diagonalization}
@@ -158,9 +171,12 @@ public:
 		VectorSizeType sectors;
 		targetedSymmetrySectors(sectors,target.lrs());
 		reflectionOperator_.update(sectors);
+		// the matrices built below are also those of targeting
+		target.clearLanczosMatrices();
 		RealType gsEnergy = internalMain_(target,direction,loopIndex,blockLeft);
 		//  targeting:
 		target.evolve(gsEnergy,direction,blockLeft,blockRight,loopIndex);
+		target.clearLanczosMatrices();
 		wft_.triggerOff(target.lrs());
 		return gsEnergy;
 	}
@@ -173,13 +189,31 @@ public:
 		PsimagLite::Profiling profiling("Diagonalization", std::cout);
 		assert(direction != ProgramGlobals::DirectionEnum::INFINITE);
 
+		// the matrices built below are also those of targeting
+		target.clearLanczosMatrices();
 		RealType gsEnergy = internalMain_(target,direction,loopIndex,block);
 		//  targeting:
 		target.evolve(gsEnergy,direction,block,block,loopIndex);
+		target.clearLanczosMatrices();
 		wft_.triggerOff(target.lrs());
 		return gsEnergy;
 	}
 
+	// Used only with adaptiveLanczosEps, see adaptTolerance below
+	void truncationError(RealType error) { truncationError_ = error; }
+
+	// Eigensolver steps summed over the sectors of the last call
+	SizeType solverSteps() const { return solverSteps_; }
+
+	// Estimated flops of the eigensolver products of the last call
+	RealType flops() const { return flops_; }
+
+	// Symmetry sectors diagonalized in the last call
+	const VectorSizeType& sectors() const { return sectors_; }
+
+	// Time spent in the initial guess (the WFT) in the last call
+	const PsimagLite::MemoryUsage::TimeHandle& wftTime() const { return wftTime_; }
+
 private:
 
 	void targetedSymmetrySectors(VectorSizeType& mVector,
@@ -202,6 +236,10 @@ private:
 		bool findSymmetrySector = (options.find("findSymmetrySector") != PsimagLite::String::npos);
 		const LeftRightSuperType& lrs= target.lrs();
 		wft_.triggerOn();
+		solverSteps_ = 0;
+		flops_ = 0;
+		sectors_.clear();
+		wftTime_ = PsimagLite::MemoryUsage::TimeHandle(0, 0);
 
 		RealType gsEnergy = 0;
 		const SizeType saveOption = parameters_.finiteLoop[loopIndex].saveOption;
@@ -248,10 +286,13 @@ private:
 			throw PsimagLite::RuntimeError(msg);
 		}
 
+		sectors_ = sectors;
 		SizeType totalSectors = sectors.size();
 		VectorWithOffsetType initialVector(weights, lrs.super());
 
+		const PsimagLite::MemoryUsage::TimeHandle time1 = PsimagLite::ProgressIndicator::time();
 		target.initialGuess(initialVector, block, noguess);
+		wftTime_ = PsimagLite::ProgressIndicator::time() - time1;
 
 		typename PsimagLite::Vector<RealType>::Type energySaved(totalSectors);
 		typename PsimagLite::Vector<TargetVectorType>::Type vecSaved(totalSectors);
@@ -288,7 +329,8 @@ private:
 				                    lrs,
 				                    target.time(),
 				                    initialVectorBySector,
-				                    loopIndex);
+				                    loopIndex,
+				                    target.lanczosMatrices());
 			}
 
 			energySaved[j] = gsEnergy;
@@ -337,8 +379,7 @@ private:
 
 		target.gs().set(vecSaved, sectors, lrs.super());
 
-		if (PsimagLite::Concurrency::root())
-			oldEnergy_ = gsEnergy;
+		oldEnergy_ = gsEnergy;
 
 		return gsEnergy;
 	}
@@ -352,7 +393,8 @@ private:
 	                         const LeftRightSuperType& lrs,
 	                         RealType targetTime,
 	                         const TargetVectorType& initialVector,
-	                         SizeType loopIndex)
+	                         SizeType loopIndex,
+	                         const LanczosMatrixCacheType& lanczosMatrices)
 	{
 		PsimagLite::String options = parameters_.options;
 		bool dumperEnabled = (options.find("KroneckerDumper") != PsimagLite::String::npos);
@@ -364,15 +406,40 @@ private:
 		if (lrs.super().block().size() == model_.geometry().numberOfSites())
 			paramsKrDumperPtr = &paramsKrDumper;
 
+		const SizeType saveOption = parameters_.finiteLoop[loopIndex].saveOption;
+		const bool debugMatrix = (options.find("debugmatrix") != PsimagLite::String::npos &&
+		                          !(saveOption & 4));
+		ReflectionSymmetryType *rs = 0;
+		if (reflectionOperator_.isEnabled()) rs = &reflectionOperator_;
+
+		// built as targeting builds it, so the matrix is taken from, and left
+		// in, the cache that targeting uses next
+		if (!rs && !paramsKrDumperPtr && !debugMatrix) {
+			assert(&lanczosMatrices.lrs() == &lrs);
+			const typename LanczosMatrixCacheType::BuiltPtrType built =
+			        lanczosMatrices(partitionIndex, targetTime);
+			PsimagLite::OstringStream msg;
+			msg<<"I will now diagonalize a matrix of size="<<built->hc().modelHelper().size();
+			progress_.printline(msg,std::cout);
+			diagonaliseOneBlock(tmpVec,
+			                    energyTmp,
+			                    built->hc(),
+			                    built->matrix(),
+			                    initialVector,
+			                    loopIndex);
+			return;
+		}
+
+		// only debugmatrix, reflection symmetry and the Kronecker dumper get here
 		HamiltonianConnectionType hc(partitionIndex,
 		                             lrs,
 		                             model_.geometry(),
 		                             ModelType::modelLinks(),
 		                             targetTime,
 		                             paramsKrDumperPtr);
+		hc.buildOperators();
 
-		const SizeType saveOption = parameters_.finiteLoop[loopIndex].saveOption;
-		if (options.find("debugmatrix")!=PsimagLite::String::npos && !(saveOption & 4) ) {
+		if (debugMatrix) {
 			SparseMatrixType fullm;
 
 			model_.fullHamiltonian(fullm, hc);
@@ -408,26 +475,23 @@ private:
 		PsimagLite::OstringStream msg;
 		msg<<"I will now diagonalize a matrix of size="<<hc.modelHelper().size();
 		progress_.printline(msg,std::cout);
+
+		MatrixVectorType lanczosHelper(model_, hc, rs);
 		diagonaliseOneBlock(tmpVec,
 		                    energyTmp,
 		                    hc,
+		                    lanczosHelper,
 		                    initialVector,
 		                    loopIndex);
 	}
 
 	void diagonaliseOneBlock(TargetVectorType& tmpVec,
 	                         RealType &energyTmp,
-	                         HamiltonianConnectionType& hc,
+	                         const HamiltonianConnectionType& hc,
+	                         const MatrixVectorType& lanczosHelper,
 	                         const TargetVectorType& initialVector,
 	                         SizeType loopIndex)
 	{
-		ReflectionSymmetryType *rs = 0;
-		if (reflectionOperator_.isEnabled()) rs = &reflectionOperator_;
-
-		typename LanczosOrDavidsonBaseType::MatrixType lanczosHelper(model_,
-		                                                             hc,
-		                                                             rs);
-
 		const SizeType saveOption = parameters_.finiteLoop[loopIndex].saveOption;
 
 		if ((saveOption & 4)>0) {
@@ -439,6 +503,20 @@ private:
 		}
 
 		ParametersForSolverType params(io_, "Lanczos", loopIndex);
+		adaptTolerance(params, loopIndex);
+
+		bool useBlockDavidson = (parameters_.options.find("useBlockDavidson") !=
+		        PsimagLite::String::npos);
+		if (useBlockDavidson && lanczosHelper.rows() > 0) {
+			try {
+				energyTmp = computeLevelsBlock(lanczosHelper, hc, params, tmpVec, initialVector);
+			} catch (std::exception& e) {
+				exactDiagonalization(tmpVec, energyTmp, lanczosHelper, e, parameters_.excited);
+			}
+
+			return;
+		}
+
 		LanczosOrDavidsonBaseType* lanczosOrDavidson = 0;
 
 		bool useDavidson = (parameters_.options.find("useDavidson") !=
@@ -465,29 +543,92 @@ private:
 
 		try {
 			energyTmp = computeLevel(*lanczosOrDavidson,tmpVec,initialVector);
+			if (!useDavidson) {
+				const SizeType steps = static_cast<LanczosSolverType*>(lanczosOrDavidson)->steps();
+				solverSteps_ += steps;
+				flops_ += steps*lanczosHelper.flopsPerProduct();
+				PsimagLite::OstringStream msg;
+				msg<<"LanczosSteps="<<steps;
+				msg<<" with tolerance="<<params.tolerance;
+				progress_.printline(msg,std::cout);
+			}
 		} catch (std::exception& e) {
-			PsimagLite::OstringStream msg0;
-			msg0<<e.what()<<"\n";
-			msg0<<"Lanczos or Davidson solver failed, ";
-			msg0<<"trying with exact diagonalization...";
-			progress_.printline(msg0,std::cout);
-			progress_.printline(msg0,std::cerr);
-
-			VectorRealType eigs(lanczosHelper.rows());
-			PsimagLite::Matrix<ComplexOrRealType> fm;
-			lanczosHelper.fullDiag(eigs,fm);
-			for (SizeType j = 0; j < eigs.size(); ++j)
-				tmpVec[j] = fm(j, 0);
-			energyTmp = eigs[0];
-
-			PsimagLite::OstringStream msg1;
-			msg1<<"Found lowest eigenvalue= "<<energyTmp<<" ";
-			progress_.printline(msg1,std::cout);
+			exactDiagonalization(tmpVec, energyTmp, lanczosHelper, e, 0);
 		}
 
 		if (lanczosOrDavidson) delete lanczosOrDavidson;
 	}
 
+	// fallback when the iterative solver fails; state 0 is the lowest
+	void exactDiagonalization(TargetVectorType& tmpVec,
+	                          RealType& energyTmp,
+	                          const MatrixVectorType& lanczosHelper,
+	                          const std::exception& e,
+	                          SizeType state)
+	{
+		PsimagLite::OstringStream msg0;
+		msg0<<e.what()<<"\n";
+		msg0<<"Lanczos or Davidson solver failed, ";
+		msg0<<"trying with exact diagonalization...";
+		progress_.printline(msg0,std::cout);
+		progress_.printline(msg0,std::cerr);
+
+		VectorRealType eigs(lanczosHelper.rows());
+		PsimagLite::Matrix<ComplexOrRealType> fm;
+		lanczosHelper.fullDiag(eigs,fm);
+		assert(state < eigs.size());
+		for (SizeType j = 0; j < eigs.size(); ++j)
+			tmpVec[j] = fm(j, state);
+		energyTmp = eigs[state];
+
+		PsimagLite::OstringStream msg1;
+		if (state == 0)
+			msg1<<"Found lowest eigenvalue= "<<energyTmp<<" ";
+		else
+			msg1<<"Found eigenvalue number "<<state<<"= "<<energyTmp<<" ";
+		progress_.printline(msg1,std::cout);
+	}
+
+	/* PSIDOC AdaptiveLanczosEps
+	With \verb!adaptiveLanczosEps! in SolverOptions the tolerance of the
+	eigensolver in the finite loops follows the accuracy that the truncation
+	allows: it is set to
+	$\max(\epsilon, \min(w/10, |\Delta E|/10))$, where $\epsilon$ is LanczosEps,
+	$w$ is the truncation error of the last step, and
+	$\Delta E$ the change in energy between the ends of the two previous finite loops.
+	LanczosEps is used until two finite loops have ended, and in the last two
+	finite loops.
+	*/
+	void adaptTolerance(ParametersForSolverType& params, SizeType loopIndex)
+	{
+		// oldEnergy_ is the energy at the end of the loop that just ended
+		if (loopIndex != lastLoopIndex_) {
+			if (loopEnds_ > 0)
+				energyChange_ = fabs(oldEnergy_ - energyOfPreviousLoop_);
+			energyOfPreviousLoop_ = oldEnergy_;
+			lastLoopIndex_ = loopIndex;
+			++loopEnds_;
+		}
+
+		if (parameters_.options.find("adaptiveLanczosEps") == PsimagLite::String::npos)
+			return;
+
+		if (truncationError_ < 0 || loopEnds_ < 2) return;
+
+		const SizeType finalLoops = 2;
+		if (loopIndex + finalLoops >= parameters_.finiteLoop.size()) return;
+
+		const RealType tenth = 0.1;
+		RealType tol = std::min(tenth*truncationError_, tenth*energyChange_);
+		if (tol <= params.tolerance) return;
+
+		PsimagLite::OstringStream msg;
+		msg<<"Adaptive tolerance="<<tol<<" (instead of "<<params.tolerance;
+		msg<<") truncation error="<<truncationError_<<" energy change="<<energyChange_;
+		progress_.printline(msg,std::cout);
+		params.tolerance = tol;
+	}
+
 	RealType computeLevel(LanczosOrDavidsonBaseType& object,
 	                      TargetVectorType& gsVector,
 	                      const TargetVectorType& initialVector) const
@@ -510,6 +651,40 @@ private:
 		return gsEnergy;
 	}
 
+	// All states up to and including excited are converged together;
+	// throws if they do not converge, so that exactDiagonalization is used
+	RealType computeLevelsBlock(const MatrixVectorType& lanczosHelper,
+	                            const HamiltonianConnectionType& hc,
+	                            const ParametersForSolverType& params,
+	                            TargetVectorType& gsVector,
+	                            const TargetVectorType& initialVector)
+	{
+		SizeType excited = parameters_.excited;
+		if (excited >= lanczosHelper.rows())
+			err("FATAL: useBlockDavidson: Excited= larger than the symmetry sector\n");
+
+		TargetVectorType init = initialVector;
+		RealType norma = PsimagLite::norm(initialVector);
+		if (fabs(norma) < 1e-12) {
+			PsimagLite::OstringStream msg;
+			msg<<"WARNING: computeLevelsBlock: Norm of guess vector is zero, ";
+			msg<<"ignoring guess\n";
+			progress_.printline(msg, std::cout);
+			PsimagLite::fillRandom(init);
+		}
+
+		VectorRealType diagonal;
+		hc.diagonal(diagonal);
+		BlockDavidsonSolverType blockDavidson(lanczosHelper, diagonal, params);
+		VectorRealType eigs;
+		typename PsimagLite::Vector<TargetVectorType>::Type z;
+		blockDavidson.computeStates(eigs, z, init, excited + 1);
+		solverSteps_ += blockDavidson.matvecs();
+		flops_ += blockDavidson.matvecs()*lanczosHelper.flopsPerProduct();
+		gsVector = z[excited];
+		return eigs[excited];
+	}
+
 	RealType slowWft(const typename LanczosOrDavidsonBaseType::MatrixType& object,
 	                 TargetVectorType& gsVector,
 	                 const TargetVectorType& initialVector) const
@@ -557,6 +732,15 @@ private:
 	const QnType& quantumSector_;
 	WaveFunctionTransfType& wft_;
 	RealType oldEnergy_;
+	RealType truncationError_;
+	RealType energyChange_;
+	RealType energyOfPreviousLoop_;
+	SizeType lastLoopIndex_;
+	SizeType loopEnds_;
+	SizeType solverSteps_;
+	RealType flops_;
+	VectorSizeType sectors_;
+	PsimagLite::MemoryUsage::TimeHandle wftTime_;
 }; // class Diagonalization
 } // namespace Dmrg
 
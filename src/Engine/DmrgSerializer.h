@@ -148,7 +148,10 @@ public:
 	           typename PsimagLite::EnableIf<
 	           PsimagLite::IsOutputLike<SomeIoOutType>::True, int>::Type = 0) const
 	{
-		if (counter == 0) io.createGroup(prefix);
+		if (counter == 0) {
+			io.createGroup(prefix);
+			io.write(numberOfSites, prefix + "/NumberOfSites");
+		}
 
 		io.write(counter + 1,
 		         prefix + "/Size",
@@ -168,6 +171,8 @@ public:
 
 		transform_.write(prefix + "/transform", io);
 		io.write(direction_, prefix + "/direction");
+		// so that readers can find a site without reading the bases
+		io.write(site(), prefix + "/Site");
 	}
 
 	const FermionSignType& fermionicSignLeft() const
@@ -199,6 +204,20 @@ public:
 
 	ProgramGlobals::DirectionEnum direction() const { return direction_; }
 
+	// approximate number of bytes held by this object
+	SizeType memory() const
+	{
+		SizeType entries = 0;
+		for (SizeType i = 0; i < transform_.blocks(); ++i)
+			entries += transform_(i).rows()*transform_(i).cols();
+
+		for (SizeType i = 0; i < wavefunction_.sectors(); ++i)
+			entries += wavefunction_.effectiveSize(wavefunction_.sector(i));
+
+		SizeType indices = lrs_.super().size() + lrs_.left().size() + lrs_.right().size();
+		return entries*sizeof(ComplexOrRealType) + 4*indices*sizeof(SizeType);
+	}
+
 	SizeType site() const
 	{
 		return (direction_ == ProgramGlobals::DirectionEnum::EXPAND_SYSTEM) ?
@@ -93,6 +93,8 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include "PrinterInDetail.h"
 #include "Io/IoSelector.h"
 #include "TargetingBase.h"
+#include "Telemetry.h"
+#include "InSituTwoPoint.h"
 
 namespace Dmrg {
 
@@ -139,6 +141,9 @@ public:
 	typedef typename BasisWithOperatorsType::BlockDiagonalMatrixType BlockDiagonalMatrixType;
 	typedef typename BasisWithOperatorsType::QnType QnType;
 	typedef typename QnType::PairSizeType PairSizeType;
+	typedef Telemetry<RealType> TelemetryType;
+	typedef InSituTwoPoint<ModelType, LeftRightSuperType, VectorWithOffsetType>
+	InSituTwoPointType;
 
 	DmrgSolver(ModelType const &model,
 	           InputValidatorType& ioIn)
@@ -172,7 +177,10 @@ public:
 	                model.geometry(),
 	                ioOut_),
 	      energy_(0.0),
-	      saveData_(parameters_.options.find("noSaveData") == PsimagLite::String::npos)
+	      saveData_(parameters_.options.find("noSaveData") == PsimagLite::String::npos),
+	      telemetry_(parameters_.filename,
+	                 parameters_.options.find("telemetry") != PsimagLite::String::npos),
+	      inSituTwoPoint_(model)
 	{
 		std::cout<<appInfo_;
 		PsimagLite::OstringStream msg;
@@ -337,6 +345,7 @@ obtain ordered
 			msg<<" size of blk. added="<<X[step].size();
 			progress_.printline(msg,std::cout);
 			printerInDetail.print(std::cout, "infinite");
+			telemetry_.start();
 
 			lrs_.growLeftBlock(model_, pS, X[step], time); // grow system
 			bool needsRightPush = false;
@@ -353,6 +362,7 @@ obtain ordered
 			                    step);
 
 			lrs_.setToProduct(quantumSector_, initialSizeOfHashTable);
+			telemetry_.mark(TelemetryType::STAGE_GROW);
 
 			const BlockType& ystep = findRightBlock(Y,step,E);
 			energy_ = diagonalization_(psi,
@@ -360,6 +370,7 @@ obtain ordered
 			                           X[step],
 			                           ystep);
 			printEnergy(energy_);
+			telemetry_.mark(TelemetryType::STAGE_DIAG);
 
 			truncate_.changeBasisInfinite(pS, pE, psi, parameters_.keptStatesInfinite);
 
@@ -371,6 +382,12 @@ obtain ordered
 				                 ProgramGlobals::SysOrEnvEnum::SYSTEM);
 			}
 
+			telemetry_.mark(TelemetryType::STAGE_TRUNCATION);
+			writeTelemetry(0,
+			               X[step][0],
+			               ProgramGlobals::DirectionEnum::INFINITE,
+			               parameters_.keptStatesInfinite);
+
 			progress_.printMemoryUsage();
 		}
 
@@ -424,6 +441,9 @@ obtain ordered
 			msg<<". "<<(parameters_.finiteLoop.size()-i)<<" more loops to go.";
 			progress_.printline(msg,std::cout);
 
+			if (i + 1 == loopsTotal)
+				inSituTwoPoint_.start(parameters_.finiteLoop[i].stepLength);
+
 			if (i > 0) {
 				int signPrev = parameters_.finiteLoop[i - 1].stepLength;
 				int signThis = parameters_.finiteLoop[i].stepLength;
@@ -446,6 +466,8 @@ obtain ordered
 				recovery.write(psi, i + 1, stepCurrent_, lastSign, ioOut_);
 		}
 
+		inSituTwoPoint_.print(std::cout);
+
 		if (!saveData_) return;
 
 		checkpoint_.write(pS, pE, ioOut_);
@@ -516,6 +538,7 @@ obtain ordered
 
 			RealType time = target.time();
 			printerInDetail.print(std::cout, "finite");
+			telemetry_.start();
 			if (direction == ProgramGlobals::DirectionEnum::EXPAND_SYSTEM) {
 				lrs_.growLeftBlock(model_, pS, sitesIndices_[stepCurrent_], time);
 				lrs_.right(dummyBwo = checkpoint_.shrink(ProgramGlobals::SysOrEnvEnum::ENVIRON));
@@ -532,14 +555,17 @@ obtain ordered
 			updateQuantumSector(lrs_.sites(),direction,stepCurrent_);
 
 			lrs_.setToProduct(quantumSector_, initialSizeOfHashTable);
+			telemetry_.mark(TelemetryType::STAGE_GROW);
 
 			energy_ = diagonalization_(target,
 			                           direction,
 			                           sitesIndices_[stepCurrent_],
 			                           loopIndex);
 			printEnergy(energy_);
+			telemetry_.mark(TelemetryType::STAGE_DIAG);
 
 			changeTruncateAndSerialize(pS,pE,target,keptStates,direction,loopIndex);
+			writeTelemetry(loopIndex, sitesIndices_[stepCurrent_][0], direction, keptStates);
 
 			if (finalStep(stepLength, stepFinal)) break;
 
@@ -573,7 +599,11 @@ obtain ordered
 
 		FermionSignType fsE(pE.signs());
 
+		inSituTwoPoint_.measure(lrs_, target.gs(), sitesIndices_[stepCurrent_], direction);
+
 		truncate_.changeBasisFinite(pS, pE, target, keptStates, direction);
+		inSituTwoPoint_.transform(truncate_.transform(direction), direction);
+		diagonalization_.truncationError(truncate_.error());
 
 		if (direction == ProgramGlobals::DirectionEnum::EXPAND_SYSTEM)
 			checkpoint_.push((twoSiteDmrg) ? lrs_.left() : pS,
@@ -582,7 +612,39 @@ obtain ordered
 			checkpoint_.push((twoSiteDmrg) ? lrs_.right() : pE,
 			                 ProgramGlobals::SysOrEnvEnum::ENVIRON);
 
+		telemetry_.mark(TelemetryType::STAGE_TRUNCATION);
 		write(fsS,fsE,target,direction,loopIndex);
+		telemetry_.mark(TelemetryType::STAGE_IO);
+	}
+
+	void writeTelemetry(SizeType loopIndex,
+	                    SizeType site,
+	                    ProgramGlobals::DirectionEnum direction,
+	                    SizeType keptStates)
+	{
+		if (!telemetry_.enabled()) return;
+
+		telemetry_.wft(diagonalization_.wftTime());
+
+		const VectorSizeType& sectors = diagonalization_.sectors();
+		VectorSizeType sectorSizes(sectors.size());
+		for (SizeType i = 0; i < sectors.size(); ++i) {
+			const SizeType j = sectors[i];
+			sectorSizes[i] = lrs_.super().partition(j + 1) - lrs_.super().partition(j);
+		}
+
+		telemetry_.write(loopIndex,
+		                 site,
+		                 direction,
+		                 keptStates,
+		                 lrs_.left().size(),
+		                 lrs_.right().size(),
+		                 lrs_.super().size(),
+		                 sectorSizes,
+		                 diagonalization_.solverSteps(),
+		                 diagonalization_.flops(),
+		                 energy_,
+		                 truncate_.error());
 	}
 
 	void write(const FermionSignType& fsS,
@@ -711,6 +773,8 @@ obtain ordered
 	ObservablesInSituType inSitu_;
 	RealType energy_;
 	bool saveData_;
+	TelemetryType telemetry_;
+	InSituTwoPointType inSituTwoPoint_;
 }; //class DmrgSolver
 } // namespace Dmrg
 
@@ -85,7 +85,6 @@ namespace Dmrg {
 
 class FermionSign {
 
-	typedef PsimagLite::PackIndices PackIndicesType;
 	typedef PsimagLite::Vector<SizeType>::Type VectorSizeType;
 	typedef PsimagLite::Vector<bool>::Type VectorBoolType;
 
@@ -95,25 +94,21 @@ public:
 	    : signs_(signs)
 	{}
 
+	// signs of the states of basis before it grew by a site with signs;
+	// each of them is found from its product with the first site state
 	template<typename SomeBasisType>
 	FermionSign(const SomeBasisType& basis,const VectorBoolType& signs)
 	{
 		if (basis.oldSigns().size() != basis.permutationInverse().size())
 			err("FermionSign: Problem\n");
 
-		SizeType n = basis.oldSigns().size();
+		assert(signs.size() > 0);
 		SizeType nx = basis.oldSigns().size()/signs.size();
-		PackIndicesType pack(nx);
 		signs_.resize(nx);
-		for (SizeType x = 0; x < n; ++x) {
-			SizeType x0 = 0;
-			SizeType x1 = 0;
-			pack.unpack(x0, x1, basis.permutation(x));
-			assert(x1 < signs.size());
-			bool parity1 = basis.oldSigns()[x];
-			bool parity2 = signs[x1];
-			assert(x0 < signs_.size());
-			signs_[x0] = (parity1 != parity2);
+		for (SizeType x0 = 0; x0 < nx; ++x0) {
+			SizeType x = basis.permutationInverse(x0);
+			assert(x < basis.oldSigns().size());
+			signs_[x0] = (basis.oldSigns()[x] != signs[0]);
 		}
 	}
 
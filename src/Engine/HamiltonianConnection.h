@@ -108,6 +108,7 @@ public:
 	typedef std::pair<SizeType,SizeType> PairType;
 	typedef typename GeometryType::AdditionalDataType AdditionalDataType;
 	typedef typename PsimagLite::Vector<ComplexOrRealType>::Type VectorType;
+	typedef typename PsimagLite::Vector<RealType>::Type VectorRealType;
 	typedef typename PsimagLite::Vector<VectorType>::Type VectorVectorType;
 	typedef typename PsimagLite::Concurrency ConcurrencyType;
 	typedef PsimagLite::Vector<SizeType>::Type VectorSizeType;
@@ -212,6 +213,22 @@ public:
 		matrix += matrix2;
 	}
 
+	// Diagonal of the Hamiltonian of this partition, computed entry by entry
+	// from the diagonals of H_L, H_R and of the operators of each link;
+	// no term of ModelCommon::fullHamiltonian is built
+	void diagonal(VectorRealType& d) const
+	{
+		d.assign(modelHelper_.size(), 0.0);
+		modelHelper_.hamiltonianDiagonal(d);
+
+		for (SizeType x = 0; x < lps_.size(); ++x) {
+			SparseMatrixType const* A = 0;
+			SparseMatrixType const* B = 0;
+			const LinkType& link2 = getKron(&A, &B, x);
+			modelHelper_.fastOpProdInterDiagonal(d, *A, *B, link2);
+		}
+	}
+
 	const LinkType& getKron(const SparseMatrixType** A,
 	                        const SparseMatrixType** B,
 	                        SizeType xx) const
@@ -229,17 +246,9 @@ public:
 		        (link2.type == ProgramGlobals::ConnectionEnum::SYSTEM_ENVIRON) ?
 		            ProgramGlobals::SysOrEnvEnum::ENVIRON : ProgramGlobals::SysOrEnvEnum::SYSTEM;
 
-		SizeType i = PsimagLite::indexOrMinusOne(modelHelper_.leftRightSuper().super().block(),
-		                                         link2.site1);
-		SizeType j = PsimagLite::indexOrMinusOne(modelHelper_.leftRightSuper().super().block(),
-		                                         link2.site2);
-
-		int offset = modelHelper_.leftRightSuper().left().block().size();
-
-		SizeType site1Corrected = (link2.type == ProgramGlobals::ConnectionEnum::SYSTEM_ENVIRON) ?
-		            i : i - offset;
-		SizeType site2Corrected = (link2.type == ProgramGlobals::ConnectionEnum::SYSTEM_ENVIRON) ?
-		            j - offset : j;
+		SizeType site1Corrected = 0;
+		SizeType site2Corrected = 0;
+		correctedSites(site1Corrected, site2Corrected, link2);
 
 		*A = &modelHelper_.reducedOperator(link2.mods.first,
 		                                   site1Corrected,
@@ -259,6 +268,36 @@ public:
 		return link2;
 	}
 
+	// Builds the operators of the left and right blocks that the links use,
+	// which Operators may still keep as factors, so that getKron only reads
+	// them. Call it before products of this connection run in threads
+	void buildOperators() const
+	{
+		const LeftRightSuperType& lrs = modelHelper_.leftRightSuper();
+		VectorSizeType left;
+		VectorSizeType right;
+		for (SizeType x = 0; x < lps_.size(); ++x) {
+			const LinkType& link2 = lps_[x];
+			SizeType site1Corrected = 0;
+			SizeType site2Corrected = 0;
+			correctedSites(site1Corrected, site2Corrected, link2);
+			if (link2.type == ProgramGlobals::ConnectionEnum::SYSTEM_ENVIRON) {
+				left.push_back(lrs.left().getOperatorIndices(site1Corrected,
+				                                             link2.ops.first).first);
+				right.push_back(lrs.right().getOperatorIndices(site2Corrected,
+				                                               link2.ops.second).first);
+			} else {
+				right.push_back(lrs.right().getOperatorIndices(site1Corrected,
+				                                               link2.ops.first).first);
+				left.push_back(lrs.left().getOperatorIndices(site2Corrected,
+				                                             link2.ops.second).first);
+			}
+		}
+
+		lrs.left().buildOperators(left);
+		lrs.right().buildOperators(right);
+	}
+
 	KroneckerDumperType& kroneckerDumper() const
 	{
 		return kroneckerDumper_;
@@ -270,6 +309,24 @@ public:
 
 private:
 
+	// sites of link2, each counted from the start of its own block
+	void correctedSites(SizeType& site1Corrected,
+	                    SizeType& site2Corrected,
+	                    const LinkType& link2) const
+	{
+		SizeType i = PsimagLite::indexOrMinusOne(modelHelper_.leftRightSuper().super().block(),
+		                                         link2.site1);
+		SizeType j = PsimagLite::indexOrMinusOne(modelHelper_.leftRightSuper().super().block(),
+		                                         link2.site2);
+
+		int offset = modelHelper_.leftRightSuper().left().block().size();
+
+		site1Corrected = (link2.type == ProgramGlobals::ConnectionEnum::SYSTEM_ENVIRON) ?
+		            i : i - offset;
+		site2Corrected = (link2.type == ProgramGlobals::ConnectionEnum::SYSTEM_ENVIRON) ?
+		            j - offset : j;
+	}
+
 	SizeType cacheConnections(SizeType x)
 	{
 		const VectorSizeType& hItems = hamAbstract_.item(x);
@@ -0,0 +1,286 @@
+#ifndef INSITUTWOPOINT_H
+#define INSITUTWOPOINT_H
+#include "Vector.h"
+#include "Matrix.h"
+#include "CrsMatrix.h"
+#include "PackIndices.h"
+#include "ProgressIndicator.h"
+#include "ProgramGlobals.h"
+#include "FermionSign.h"
+#include "BlockOffDiagMatrix.h"
+#include "Braket.h"
+
+namespace Dmrg {
+
+/* PSIDOC InSituTwoPoint
+With \verb!InSituTwoPoint=! in the input, a comma-separated list of
+two-point brakets like \verb!"<gs|c';c|gs>,<gs|n;n|gs>"!, DMRG++ computes
+these correlations during the last finite loop, so that the observe
+program is not needed for them.
+The last finite loop must move to the right, and should start at the
+left end of the lattice, for example after a loop that moves all the way to the left.
+For each site passed in that loop the operator of the first point is
+kept in the basis of the left block, and is grown and transformed at each step;
+at each step these operators are closed against the operator of the second point
+on the current site and the ground state.
+The correlations are printed at the end of the finite loops with the same
+layout as observe; entries not computed, below the diagonal or for sites
+not passed, are zero, and so is the last site.
+Memory grows with the number of sites passed times the number of brakets,
+each kept operator being a matrix of the size of the left block.
+With these correlations in situ, and nothing else needed from observe,
+the saving of data can be turned off in FiniteLoops.
+*/
+template<typename ModelType, typename LeftRightSuperType, typename VectorWithOffsetType>
+class InSituTwoPoint {
+
+	typedef typename LeftRightSuperType::BasisWithOperatorsType BasisWithOperatorsType;
+	typedef typename BasisWithOperatorsType::BasisType BasisType;
+	typedef typename BasisWithOperatorsType::OperatorType OperatorType;
+	typedef typename BasisWithOperatorsType::BlockDiagonalMatrixType BlockDiagonalMatrixType;
+	typedef typename OperatorType::StorageType SparseMatrixType;
+	typedef typename SparseMatrixType::value_type ComplexOrRealType;
+	typedef PsimagLite::Matrix<ComplexOrRealType> MatrixType;
+	typedef BlockOffDiagMatrix<MatrixType> BlockOffDiagMatrixType;
+	typedef Braket<ModelType> BraketType;
+	typedef typename PsimagLite::Vector<OperatorType>::Type VectorOperatorType;
+	typedef typename PsimagLite::Vector<SparseMatrixType>::Type VectorSparseMatrixType;
+	typedef typename PsimagLite::Vector<VectorSparseMatrixType>::Type VectorVectorSparseMatrixType;
+	typedef typename PsimagLite::Vector<MatrixType>::Type VectorMatrixType;
+	typedef PsimagLite::Vector<PsimagLite::String>::Type VectorStringType;
+	typedef PsimagLite::Vector<SizeType>::Type VectorSizeType;
+	typedef typename PsimagLite::Vector<bool>::Type VectorBoolType;
+	typedef PsimagLite::PackIndices PackIndicesType;
+
+public:
+
+	InSituTwoPoint(const ModelType& model)
+	    : model_(model), progress_("InSituTwoPoint"), active_(false)
+	{
+		if (model.params().insituTwoPoint == "") return;
+
+		if (BasisType::useSu2Symmetry())
+			err("InSituTwoPoint: not supported with SU(2)\n");
+
+		PsimagLite::split(labels_, model.params().insituTwoPoint, ",");
+		for (SizeType i = 0; i < labels_.size(); ++i) {
+			BraketType braket(model, labels_[i]);
+			if (braket.points() != 2)
+				err("InSituTwoPoint: " + labels_[i] + " is not a two-point braket\n");
+
+			if (braket.bra() != "gs" || braket.ket() != "gs")
+				err("InSituTwoPoint: " + labels_[i] + " must be <gs|...|gs>\n");
+
+			ops1_.push_back(braket.op(0));
+			ops2_.push_back(braket.op(1));
+		}
+	}
+
+	bool enabled() const { return (labels_.size() > 0); }
+
+	// to be called at the beginning of the last finite loop
+	void start(int stepLength)
+	{
+		if (!enabled()) return;
+
+		if (stepLength < 0) {
+			PsimagLite::OstringStream msg;
+			msg<<"WARNING: last finite loop moves to the left; nothing measured";
+			progress_.printline(msg, std::cout);
+			return;
+		}
+
+		const SizeType n = model_.geometry().numberOfSites();
+		active_ = true;
+		sites_.clear();
+		grown_.clear();
+		grown_.resize(labels_.size());
+		results_.resize(labels_.size());
+		for (SizeType k = 0; k < results_.size(); ++k) {
+			results_[k].resize(n, n);
+			results_[k].setTo(0.0);
+		}
+	}
+
+	// to be called after diagonalization and before truncation;
+	// the left block of lrs has just grown by block[0]
+	void measure(const LeftRightSuperType& lrs,
+	             const VectorWithOffsetType& psi,
+	             const VectorSizeType& block,
+	             ProgramGlobals::DirectionEnum direction)
+	{
+		if (!active_ || direction != ProgramGlobals::DirectionEnum::EXPAND_SYSTEM)
+			return;
+
+		if (block.size() != 1)
+			err("InSituTwoPoint: needs one site per block\n");
+
+		const SizeType site = block[0];
+		const SizeType hilbert = model_.hilbertSize(site);
+		const SizeType nx = lrs.left().size()/hilbert;
+
+		VectorBoolType oddElectrons;
+		model_.findOddElectronsOfOneSite(oddElectrons, site);
+		FermionSign fs(lrs.left(), oddElectrons);
+
+		SparseMatrixType identityBlock;
+		identityBlock.makeDiagonal(nx, 1.0);
+		SparseMatrixType identitySite;
+		identitySite.makeDiagonal(hilbert, 1.0);
+
+		for (SizeType k = 0; k < labels_.size(); ++k) {
+			const OperatorType& op1 = ops1_[k];
+			const OperatorType& op2 = ops2_[k];
+			if (op1.data.rows() != hilbert || op2.data.rows() != hilbert)
+				err("InSituTwoPoint: operators of " + labels_[k] + " do not fit site\n");
+
+			VectorSparseMatrixType& grown = grown_[k];
+			SparseMatrixType tmp;
+			for (SizeType x = 0; x < grown.size(); ++x) {
+				if (grown[x].rows() != nx)
+					err("InSituTwoPoint: steps of the last finite loop are not contiguous\n");
+
+				product(tmp, grown[x], op2.data, fs, op1.fermionOrBoson, lrs.left());
+				results_[k](sites_[x], site) = bracket(tmp, psi, lrs);
+
+				product(tmp,
+				        grown[x],
+				        identitySite,
+				        fs,
+				        ProgramGlobals::FermionOrBosonEnum::BOSON,
+				        lrs.left());
+				grown[x].swap(tmp);
+			}
+
+			SparseMatrixType op12 = op1.data*op2.data;
+			product(tmp,
+			        identityBlock,
+			        op12,
+			        fs,
+			        ProgramGlobals::FermionOrBosonEnum::BOSON,
+			        lrs.left());
+			results_[k](site, site) = bracket(tmp, psi, lrs);
+
+			grown.push_back(SparseMatrixType());
+			product(grown[grown.size() - 1],
+			        identityBlock,
+			        op1.data,
+			        fs,
+			        op1.fermionOrBoson,
+			        lrs.left());
+		}
+
+		sites_.push_back(site);
+	}
+
+	// to be called after truncation, with its transform
+	void transform(const BlockDiagonalMatrixType& transform,
+	               ProgramGlobals::DirectionEnum direction)
+	{
+		if (!active_ || direction != ProgramGlobals::DirectionEnum::EXPAND_SYSTEM)
+			return;
+
+		for (SizeType k = 0; k < grown_.size(); ++k) {
+			VectorSparseMatrixType& grown = grown_[k];
+			for (SizeType x = 0; x < grown.size(); ++x) {
+				BlockOffDiagMatrixType m(grown[x], transform.offsetsRows());
+				m.transform(transform);
+				m.toSparse(grown[x]);
+			}
+		}
+	}
+
+	// to be called at the end of the finite loops
+	void print(std::ostream& os)
+	{
+		if (!active_) return;
+
+		for (SizeType k = 0; k < labels_.size(); ++k) {
+			os<<labels_[k]<<"\n";
+			os<<results_[k];
+		}
+
+		active_ = false;
+		grown_.clear();
+	}
+
+private:
+
+	// result = O1 x O2 in the basis of left, with the sign of O2 going
+	// past the states of O1
+	static void product(SparseMatrixType& result,
+	                    const SparseMatrixType& O1,
+	                    const SparseMatrixType& O2,
+	                    const FermionSign& fs,
+	                    ProgramGlobals::FermionOrBosonEnum fOrB,
+	                    const BasisWithOperatorsType& left)
+	{
+		const int fermionicSign = (fOrB == ProgramGlobals::FermionOrBosonEnum::BOSON) ? 1 : -1;
+		const SizeType ni = O1.rows();
+		const SizeType n = left.size();
+		assert(ni*O2.rows() == n);
+
+		SparseMatrixType ret(n, n, O1.nonZeros()*O2.nonZeros());
+		PackIndicesType pack(ni);
+		SizeType counter = 0;
+		for (SizeType r = 0; r < n; ++r) {
+			SizeType e = 0;
+			SizeType u = 0;
+			pack.unpack(e, u, left.permutation(r));
+			const ComplexOrRealType f = fs(e, fermionicSign);
+			ret.setRow(r, counter);
+			for (int k = O1.getRowPtr(e); k < O1.getRowPtr(e + 1); ++k) {
+				const SizeType e2 = O1.getCol(k);
+				for (int k2 = O2.getRowPtr(u); k2 < O2.getRowPtr(u + 1); ++k2) {
+					const SizeType u2 = O2.getCol(k2);
+					ret.setCol(counter, left.permutationInverse(e2 + u2*ni));
+					ret.setValues(counter++, O1.getValue(k)*O2.getValue(k2)*f);
+				}
+			}
+		}
+
+		ret.setRow(n, counter);
+		ret.checkValidity();
+		result.swap(ret);
+	}
+
+	// <psi|A|psi> with A in the basis of the left block
+	static ComplexOrRealType bracket(const SparseMatrixType& A,
+	                                 const VectorWithOffsetType& psi,
+	                                 const LeftRightSuperType& lrs)
+	{
+		ComplexOrRealType sum = 0.0;
+		PackIndicesType pack(lrs.left().size());
+		for (SizeType x = 0; x < psi.sectors(); ++x) {
+			const SizeType sector = psi.sector(x);
+			const SizeType offset = psi.offset(sector);
+			const SizeType total = offset + psi.effectiveSize(sector);
+			for (SizeType t = offset; t < total; ++t) {
+				SizeType r = 0;
+				SizeType eta = 0;
+				pack.unpack(r, eta, lrs.super().permutation(t));
+				for (int k = A.getRowPtr(r); k < A.getRowPtr(r + 1); ++k) {
+					const SizeType t2 = lrs.super().permutationInverse(A.getCol(k) +
+					                                                   eta*A.cols());
+					if (t2 < offset || t2 >= total) continue;
+					sum += A.getValue(k)*PsimagLite::conj(psi.slowAccess(t))*
+					        psi.slowAccess(t2);
+				}
+			}
+		}
+
+		return sum;
+	}
+
+	const ModelType& model_;
+	PsimagLite::ProgressIndicator progress_;
+	bool active_;
+	VectorStringType labels_;
+	VectorOperatorType ops1_;
+	VectorOperatorType ops2_;
+	VectorSizeType sites_;
+	VectorVectorSparseMatrixType grown_;
+	VectorMatrixType results_;
+}; // class InSituTwoPoint
+} // namespace Dmrg
+#endif // INSITUTWOPOINT_H
@@ -122,6 +122,12 @@ public:
 		knownLabels_.push_back("TSPTimeSteps");
 		knownLabels_.push_back("TSPAdvanceEach");
 		knownLabels_.push_back("ChebyshevTransform");
+		knownLabels_.push_back("KpmMoments");
+		knownLabels_.push_back("KpmKernel");
+		knownLabels_.push_back("KpmLambda");
+		knownLabels_.push_back("KpmOmegaBegin");
+		knownLabels_.push_back("KpmOmegaStep");
+		knownLabels_.push_back("KpmOmegaTotal");
 		knownLabels_.push_back("TSPAlgorithm");
 		knownLabels_.push_back("TSPSites");
 		knownLabels_.push_back("TSPLoops");
@@ -203,6 +209,9 @@ public:
 		knownLabels_.push_back("RecoverySave");
 		knownLabels_.push_back("RecoveryMaxFiles");
 		knownLabels_.push_back("Intent");
+		knownLabels_.push_back("MemoryBudget");
+		knownLabels_.push_back("ObserveMemoryBudget");
+		knownLabels_.push_back("InSituTwoPoint");
 		for (SizeType i = 0; i < 10; ++i)
 			knownLabels_.push_back("Term" + ttos(i));
 	}
@@ -304,7 +313,15 @@ public:
 			\item[exactdiag] Do exact diagonalization with LAPACK instead of Lanczos
 			\item[nodmrgtransform] Do not DMRG transform bases
 			\item[useDavidson] Use Davidson instead of Lanczos
+			\item[adaptiveLanczosEps] Loosen the eigensolver tolerance in early
+			finite loops according to the truncation error, see AdaptiveLanczosEps
+			\item[useBlockDavidson] Converge the lowest Excited+1 states together
+			with a block Davidson solver, see BlockDavidsonSolver
 			\item[verbose] Enable verbose output
+			\item[telemetry] Write timings and sizes of each step as JSON lines,
+			see Telemetry
+			\item[observeStream] Write two-point correlations of observe
+			row by row to a file, see CorrelationsStream
 			\item[nowft] Disable the Wave Function Transformation (WFT)
 			\item[useComplex] TBW
 			\item[inflate] TBW
@@ -313,7 +330,9 @@ public:
 			\item[ChebyshevSolver] Use ChebyshevSolver instead of Lanczos
 			\item[MatrixVectorStored] Store superblock sector of Hamiltonian matrix
 			in memory instead of constructing it on the fly.
-			\item[MatrixVectorKron] TBW
+			\item[MatrixVectorKron] Use Kronecker products for the
+			Hamiltonian sector; this is the default. With MemoryBudget= in
+			the input the engine is chosen per sector, see MatrixVectorEngineSelector
 			\item[TimeStepTargeting] TDMRG algorithm
 			\item[DynamicTargeting] TBW
 			\item[AdaptiveDynamicTargeting] TBW
@@ -369,7 +388,11 @@ public:
 		registerOpts.push_back("exactdiag");
 		registerOpts.push_back("nodmrgtransform");
 		registerOpts.push_back("useDavidson");
+		registerOpts.push_back("useBlockDavidson");
+		registerOpts.push_back("adaptiveLanczosEps");
 		registerOpts.push_back("verbose");
+		registerOpts.push_back("telemetry");
+		registerOpts.push_back("observeStream");
 		registerOpts.push_back("nofiniteloops");
 		registerOpts.push_back("nowft");
 		registerOpts.push_back("useComplex");
@@ -0,0 +1,160 @@
+#ifndef LANCZOSMATRIXCACHE_H
+#define LANCZOSMATRIXCACHE_H
+#include "Vector.h"
+#include <memory>
+#include <mutex>
+
+namespace Dmrg {
+
+/* PSIDOC LanczosMatrixCache
+Targeting needs the Hamiltonian of a symmetry sector more than once per step,
+for example to evolve in time, for correction vectors, and to print energies.
+The matrix used by the Lanczos solver for a sector, together with its
+HamiltonianConnection, is built by the diagonalization of the step, or the
+first time it is needed afterwards. It is then shared by the diagonalization
+and all targeting stages until the targeting of the step ends, so its setup,
+which includes the Kronecker arrays when they are used, is done once per
+sector and time.
+When \verb!MemoryBudget=! (in megabytes) is given, the cached matrices use
+at most that much memory, as estimated by MatrixVectorEngineSelector:
+the least recently used ones are dropped to make room, and a matrix that
+does not fit by itself is built for its caller but not kept.
+A matrix that is dropped is freed once the last stage using it is done.
+*/
+template<typename ModelType, typename MatrixLanczosType>
+class LanczosMatrixCache {
+
+	typedef typename ModelType::ModelHelperType ModelHelperType;
+	typedef typename ModelHelperType::LeftRightSuperType LeftRightSuperType;
+	typedef typename ModelType::RealType RealType;
+	typedef typename ModelType::HamiltonianConnectionType HamiltonianConnectionType;
+
+public:
+
+	// the connection of a sector and the matrix built on it, freed together
+	class Built {
+
+	public:
+
+		Built(const ModelType& model,
+		      const LeftRightSuperType& lrs,
+		      SizeType partition,
+		      RealType time)
+		    : hc_(new HamiltonianConnectionType(partition,
+		                                        lrs,
+		                                        model.geometry(),
+		                                        ModelType::modelLinks(),
+		                                        time,
+		                                        0)),
+		      matrix_(0)
+		{
+			hc_->buildOperators();
+			matrix_ = new MatrixLanczosType(model, *hc_);
+		}
+
+		~Built()
+		{
+			delete matrix_;
+			matrix_ = 0;
+			delete hc_;
+			hc_ = 0;
+		}
+
+		const HamiltonianConnectionType& hc() const { return *hc_; }
+
+		const MatrixLanczosType& matrix() const { return *matrix_; }
+
+	private:
+
+		Built(const Built&);
+
+		Built& operator=(const Built&);
+
+		HamiltonianConnectionType* hc_;
+		MatrixLanczosType* matrix_;
+	}; // class Built
+
+	// keep it while using the matrix; the cache may drop its own reference
+	typedef std::shared_ptr<const Built> BuiltPtrType;
+
+	LanczosMatrixCache(const ModelType& model, const LeftRightSuperType& lrs)
+	    : model_(model), lrs_(lrs), bytes_(0), clock_(0)
+	{}
+
+	LanczosMatrixCache(const LanczosMatrixCache&) = delete;
+
+	LanczosMatrixCache& operator=(const LanczosMatrixCache&) = delete;
+
+	// matrix of partition at time, built if not cached
+	BuiltPtrType operator()(SizeType partition, RealType time) const
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		for (SizeType i = 0; i < entries_.size(); ++i) {
+			if (entries_[i].partition != partition || entries_[i].time != time)
+				continue;
+			entries_[i].lastUse = ++clock_;
+			return entries_[i].built;
+		}
+
+		Entry entry;
+		entry.partition = partition;
+		entry.time = time;
+		entry.built = BuiltPtrType(new Built(model_, lrs_, partition, time));
+		entry.bytes = entry.built->matrix().bytes();
+		entry.lastUse = ++clock_;
+
+		const RealType budget = model_.params().memoryBudget*1024.0*1024.0;
+		if (budget > 0) {
+			if (entry.bytes > budget) return entry.built;
+			while (bytes_ + entry.bytes > budget) dropLeastRecentlyUsed();
+		}
+
+		bytes_ += entry.bytes;
+		entries_.push_back(entry);
+		return entry.built;
+	}
+
+	// must be called whenever lrs changes
+	void clear()
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		entries_.clear();
+		bytes_ = 0;
+	}
+
+	const LeftRightSuperType& lrs() const { return lrs_; }
+
+private:
+
+	struct Entry {
+		SizeType partition;
+		RealType time;
+		RealType bytes;
+		SizeType lastUse;
+		BuiltPtrType built;
+	};
+
+	typedef typename PsimagLite::Vector<Entry>::Type VectorEntryType;
+
+	// must be called with mutex_ held
+	void dropLeastRecentlyUsed() const
+	{
+		assert(entries_.size() > 0);
+		SizeType oldest = 0;
+		for (SizeType i = 1; i < entries_.size(); ++i)
+			if (entries_[i].lastUse < entries_[oldest].lastUse) oldest = i;
+
+		bytes_ -= entries_[oldest].bytes;
+		entries_.erase(entries_.begin() + oldest);
+		if (entries_.size() == 0) bytes_ = 0;
+	}
+
+	const ModelType& model_;
+	const LeftRightSuperType& lrs_;
+	mutable VectorEntryType entries_;
+	mutable RealType bytes_;
+	mutable SizeType clock_;
+	mutable std::mutex mutex_;
+}; // class LanczosMatrixCache
+} // namespace Dmrg
+#endif // LANCZOSMATRIXCACHE_H
@@ -0,0 +1,170 @@
+#ifndef MATRIXVECTORENGINESELECTOR_H
+#define MATRIXVECTORENGINESELECTOR_H
+#include "Vector.h"
+#include "ProgressIndicator.h"
+
+namespace Dmrg {
+
+/* PSIDOC MatrixVectorEngineSelector
+When \verb!MemoryBudget=! (in megabytes) is given in the input and
+MatrixVectorKron is in use (that is, neither MatrixVectorStored nor
+MatrixVectorOnTheFly are in SolverOptions) then, at every
+diagonalization and for every symmetry sector, DMRG++ estimates memory and
+floating point cost of the three matrix-vector engines:
+storing the Hamiltonian sector, Kronecker products, and on-the-fly products.
+The cheapest engine that fits in the budget is chosen, and the decision
+is printed to the cout file. If no engine fits, on-the-fly is used.
+Sectors smaller than MaxMatrixRankStored= are always stored.
+The same per-product estimate is used, for whichever engine is in use,
+to report floating point operations in the telemetry file.
+The estimates need a pass over all links of the sector, so the engines compute
+them only when MemoryBudget= is given or telemetry is on; otherwise they report
+zero flops and bytes.
+*/
+template<typename ModelType>
+class MatrixVectorEngineSelector {
+
+	typedef typename ModelType::HamiltonianConnectionType HamiltonianConnectionType;
+	typedef typename ModelType::ModelHelperType ModelHelperType;
+	typedef typename ModelHelperType::LeftRightSuperType LeftRightSuperType;
+	typedef typename ModelHelperType::SparseMatrixType SparseMatrixType;
+	typedef typename ModelHelperType::RealType RealType;
+	typedef typename SparseMatrixType::value_type ComplexOrRealType;
+
+	// rough number of matrix vector products per diagonalization;
+	// only used to amortize the setup cost of each engine
+	static const SizeType MATVECS_PER_SETUP = 100;
+
+	// on-the-fly repeats the index computation of the stored engine
+	// for every product
+	static const SizeType ONTHEFLY_OVERHEAD = 3;
+
+public:
+
+	enum EngineEnum {ENGINE_STORED, ENGINE_KRON, ENGINE_ONTHEFLY};
+
+	MatrixVectorEngineSelector(const ModelType& model,
+	                           const HamiltonianConnectionType& hc)
+	    : model_(model),
+	      engine_(ENGINE_ONTHEFLY),
+	      n_(hc.modelHelper().size()),
+	      memory_(3, 0.0),
+	      cost_(3, 0.0),
+	      flops_(3, 0.0),
+	      progress_("MatrixVectorEngineSelector")
+	{
+		const LeftRightSuperType& lrs = hc.modelHelper().leftRightSuper();
+		const RealType n = n_;
+		const RealType nl = lrs.left().size();
+		const RealType nr = lrs.right().size();
+		const RealType fraction = (nl*nr > 0) ? n/(nl*nr) : 1.0;
+		const RealType bytesPerEntry = sizeof(ComplexOrRealType) + sizeof(int);
+		const RealType bytesPerVector = n*sizeof(ComplexOrRealType);
+
+		const RealType nnzHl = lrs.left().hamiltonian().nonZeros();
+		const RealType nnzHr = lrs.right().hamiltonian().nonZeros();
+
+		RealType nnzConnections = 0;
+		RealType nnzFactors = nnzHl + nnzHr;
+		RealType kronFlops = 2.0*fraction*(nnzHl*nr + nnzHr*nl);
+		SizeType total = hc.tasks();
+		for (SizeType x = 0; x < total; ++x) {
+			SparseMatrixType const* A = 0;
+			SparseMatrixType const* B = 0;
+			hc.getKron(&A, &B, x);
+			const RealType nnzA = A->nonZeros();
+			const RealType nnzB = B->nonZeros();
+			nnzConnections += nnzA*nnzB;
+			nnzFactors += nnzA + nnzB;
+			kronFlops += 2.0*fraction*(nnzA*B->cols() + nnzB*A->rows());
+		}
+
+		RealType nnzH = fraction*(nnzHl*nr + nl*nnzHr + nnzConnections);
+		if (nnzH > n*n) nnzH = n*n;
+
+		const RealType nthreads = model.params().nthreads;
+
+		memory_[ENGINE_STORED] = nnzH*bytesPerEntry + (n + 1)*sizeof(int);
+		memory_[ENGINE_KRON] = nnzFactors*bytesPerEntry + 2*bytesPerVector;
+		memory_[ENGINE_ONTHEFLY] = nthreads*bytesPerVector;
+
+		flops_[ENGINE_STORED] = 2.0*nnzH;
+		flops_[ENGINE_KRON] = kronFlops;
+		flops_[ENGINE_ONTHEFLY] = ONTHEFLY_OVERHEAD*2.0*nnzH;
+
+		cost_[ENGINE_STORED] = 2.0*2.0*nnzH + MATVECS_PER_SETUP*flops_[ENGINE_STORED];
+		cost_[ENGINE_KRON] = 2.0*nnzFactors + MATVECS_PER_SETUP*flops_[ENGINE_KRON];
+		cost_[ENGINE_ONTHEFLY] = MATVECS_PER_SETUP*flops_[ENGINE_ONTHEFLY];
+	}
+
+	// Whether the engines need the estimates: for MemoryBudget= (to choose an
+	// engine and for LanczosMatrixCache) or for the telemetry file
+	static bool needed(const ModelType& model)
+	{
+		return (model.params().memoryBudget > 0 ||
+		        model.params().options.find("telemetry") != PsimagLite::String::npos);
+	}
+
+	// Cheapest engine that fits in MemoryBudget=; prints the decision
+	EngineEnum choose()
+	{
+		const RealType budget = model_.params().memoryBudget*1024.0*1024.0;
+		bool found = false;
+		for (SizeType i = 0; i < memory_.size(); ++i) {
+			if (memory_[i] > budget) continue;
+			if (found && cost_[i] >= cost_[engine_]) continue;
+			engine_ = static_cast<EngineEnum>(i);
+			found = true;
+		}
+
+		PsimagLite::OstringStream msg;
+		msg<<"sector="<<n_<<" budget(MB)="<<model_.params().memoryBudget;
+		for (SizeType i = 0; i < memory_.size(); ++i) {
+			msg<<" "<<engineName(static_cast<EngineEnum>(i));
+			msg<<"(MB="<<memory_[i]/(1024.0*1024.0)<<",GFlop="<<cost_[i]*1e-9<<")";
+		}
+
+		msg<<" chosen="<<engineName(engine_);
+		if (!found) msg<<" (nothing fits in budget)";
+		progress_.printline(msg, std::cout);
+		return engine_;
+	}
+
+	// Estimated floating point operations of one product with engine
+	RealType flopsPerProduct(EngineEnum engine) const { return flops_[engine]; }
+
+	// Estimated bytes that a matrix with engine keeps between products;
+	// on-the-fly only needs scratch vectors while a product runs
+	RealType bytesKept(EngineEnum engine) const
+	{
+		return (engine == ENGINE_ONTHEFLY) ? 0 : memory_[engine];
+	}
+
+	static PsimagLite::String engineName(EngineEnum engine)
+	{
+		switch (engine) {
+		case ENGINE_STORED:
+			return "Stored";
+		case ENGINE_KRON:
+			return "Kron";
+		default:
+			return "OnTheFly";
+		}
+	}
+
+private:
+
+	MatrixVectorEngineSelector(const MatrixVectorEngineSelector&);
+
+	MatrixVectorEngineSelector& operator=(const MatrixVectorEngineSelector&);
+
+	const ModelType& model_;
+	EngineEnum engine_;
+	SizeType n_;
+	typename PsimagLite::Vector<RealType>::Type memory_;
+	typename PsimagLite::Vector<RealType>::Type cost_;
+	typename PsimagLite::Vector<RealType>::Type flops_;
+	PsimagLite::ProgressIndicator progress_;
+}; // class MatrixVectorEngineSelector
+} // namespace Dmrg
+#endif // MATRIXVECTORENGINESELECTOR_H
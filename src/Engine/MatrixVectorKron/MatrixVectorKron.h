@@ -84,6 +84,7 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include "InitKronHamiltonian.h"
 #include "KronMatrix.h"
 #include "MatrixVectorBase.h"
+#include "MatrixVectorEngineSelector.h"
 
 namespace Dmrg {
 template<typename ModelType_>
@@ -109,17 +110,46 @@ public:
 	typedef PsimagLite::Matrix<ComplexOrRealType> FullMatrixType;
 	typedef typename SparseMatrixType::value_type value_type;
 	typedef typename ModelType::HamiltonianConnectionType HamiltonianConnectionType;
+	typedef MatrixVectorEngineSelector<ModelType> MatrixVectorEngineSelectorType;
+	typedef typename MatrixVectorEngineSelectorType::EngineEnum EngineEnum;
 
 	MatrixVectorKron(const ModelType& model,
 	                 const HamiltonianConnectionType& hc,
 	                 ReflectionSymmetryType* = 0)
-	    : params_(model.params()),
-	      initKron_(model, hc),
-	      kronMatrix_(initKron_, "Hamiltonian"),
+	    : model_(model),
+	      hc_(hc),
+	      params_(model.params()),
+	      engine_(MatrixVectorEngineSelectorType::ENGINE_KRON),
+	      initKron_(0),
+	      kronMatrix_(0),
+	      flops_(0),
+	      bytes_(0),
 	      time_(0, 0)
 	{
 		int maxMatrixRankStored = model.params().maxMatrixRankStored;
-		if (hc.modelHelper().size() > maxMatrixRankStored) return;
+		if (hc.modelHelper().size() <= maxMatrixRankStored)
+			engine_ = MatrixVectorEngineSelectorType::ENGINE_STORED;
+
+		if (MatrixVectorEngineSelectorType::needed(model)) {
+			MatrixVectorEngineSelectorType selector(model, hc);
+			if (engine_ != MatrixVectorEngineSelectorType::ENGINE_STORED &&
+			        model.params().memoryBudget > 0)
+				engine_ = selector.choose();
+
+			flops_ = selector.flopsPerProduct(engine_);
+			bytes_ = selector.bytesKept(engine_);
+		}
+
+		if (engine_ == MatrixVectorEngineSelectorType::ENGINE_ONTHEFLY)
+			return;
+
+		if (engine_ == MatrixVectorEngineSelectorType::ENGINE_KRON) {
+			initKron_ = new InitKronType(model, hc);
+			kronMatrix_ = new KronMatrixType(*initKron_, "Hamiltonian");
+		}
+
+		if (engine_ != MatrixVectorEngineSelectorType::ENGINE_STORED)
+			return;
 
 		model.fullHamiltonian(matrixStored_, hc);
 		assert(isHermitian(matrixStored_,true));
@@ -130,9 +160,17 @@ public:
 	~MatrixVectorKron()
 	{
 		std::cout<<"DeltaClock matrixVectorProduct "<<time_.millis()<<"\n";
+		delete kronMatrix_;
+		kronMatrix_ = 0;
+		delete initKron_;
+		initKron_ = 0;
 	}
 
-	SizeType rows() const { return initKron_.size(InitKronType::NEW); }
+	SizeType rows() const { return hc_.modelHelper().size(); }
+
+	RealType flopsPerProduct() const { return flops_; }
+
+	RealType bytes() const { return bytes_; }
 
 	template<typename SomeVectorType>
 	void matrixVectorProduct(SomeVectorType &x,SomeVectorType const &y) const
@@ -141,8 +179,10 @@ public:
 
 		if (matrixStored_.rows() > 0)
 			matrixStored_.matrixVectorProduct(x,y);
+		else if (kronMatrix_)
+			kronMatrix_->matrixVectorProduct(x,y);
 		else
-			kronMatrix_.matrixVectorProduct(x,y);
+			model_.matrixVectorProduct(x, y, hc_);
 
 		const PsimagLite::MemoryUsage::TimeHandle time2 = PsimagLite::ProgressIndicator::time();
 		const PsimagLite::MemoryUsage::TimeHandle deltaTime = time2 - time1;
@@ -156,6 +196,10 @@ public:
 
 private:
 
+	MatrixVectorKron(const MatrixVectorKron&);
+
+	MatrixVectorKron& operator=(const MatrixVectorKron&);
+
 	void checkKron() const
 	{
 		if (!CHECK_KRON)
@@ -165,6 +209,8 @@ private:
 		return;
 #endif
 
+		InitKronType initKron(model_, hc_);
+		KronMatrixType kronMatrix(initKron, "Hamiltonian");
 		SizeType n = rows();
 		std::cout<<n<<"\n";
 		FullMatrixType m(n, n);
@@ -172,7 +218,7 @@ private:
 			VectorType e(n, 0.0);
 			e[i] = 1.0;
 			VectorType ey(n, 0.0);
-			kronMatrix_.matrixVectorProduct(ey,e);
+			kronMatrix.matrixVectorProduct(ey,e);
 			for (SizeType j = 0; j < n; ++j)
 				m(i, j) = ey[j];
 
@@ -185,10 +231,15 @@ private:
 		std::cout<<matrixStored_;
 	}
 
+	const ModelType& model_;
+	const HamiltonianConnectionType& hc_;
 	const ParametersType& params_;
-	InitKronType initKron_;
-	KronMatrixType kronMatrix_;
+	EngineEnum engine_;
+	InitKronType* initKron_;
+	KronMatrixType* kronMatrix_;
 	SparseMatrixType matrixStored_;
+	RealType flops_;
+	RealType bytes_;
 	mutable PsimagLite::MemoryUsage::TimeHandle time_;
 }; // class MatrixVectorKron
 } // namespace Dmrg
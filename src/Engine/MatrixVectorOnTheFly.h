@@ -82,6 +82,7 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 
 #include <vector>
 #include "MatrixVectorBase.h"
+#include "MatrixVectorEngineSelector.h"
 
 namespace Dmrg {
 template<typename ModelType_>
@@ -101,14 +102,25 @@ public:
 	typedef typename PsimagLite::Vector<RealType>::Type VectorRealType;
 	typedef PsimagLite::Matrix<ComplexOrRealType> FullMatrixType;
 	typedef typename ModelType::HamiltonianConnectionType HamiltonianConnectionType;
+	typedef MatrixVectorEngineSelector<ModelType> MatrixVectorEngineSelectorType;
 
 	MatrixVectorOnTheFly(const ModelType& model,
 	                     const HamiltonianConnectionType& hc,
 	                     ReflectionSymmetryType* = 0)
-	    : model_(model), hc_(hc)
+	    : model_(model), hc_(hc), flops_(0), bytes_(0)
 	{
 		int maxMatrixRankStored = model.params().maxMatrixRankStored;
-		if (hc.modelHelper().size() > maxMatrixRankStored) return;
+		const bool stored = (hc.modelHelper().size() <= maxMatrixRankStored);
+		if (MatrixVectorEngineSelectorType::needed(model)) {
+			MatrixVectorEngineSelectorType selector(model, hc);
+			const typename MatrixVectorEngineSelectorType::EngineEnum engine = (stored)
+			        ? MatrixVectorEngineSelectorType::ENGINE_STORED
+			        : MatrixVectorEngineSelectorType::ENGINE_ONTHEFLY;
+			flops_ = selector.flopsPerProduct(engine);
+			bytes_ = selector.bytesKept(engine);
+		}
+
+		if (!stored) return;
 
 		model.fullHamiltonian(matrixStored_, hc);
 		assert(isHermitian(matrixStored_,true));
@@ -116,6 +128,10 @@ public:
 
 	SizeType rows() const { return hc_.modelHelper().size(); }
 
+	RealType flopsPerProduct() const { return flops_; }
+
+	RealType bytes() const { return bytes_; }
+
 	template<typename SomeVectorType>
 	void matrixVectorProduct(SomeVectorType &x,SomeVectorType const &y) const
 	{
@@ -141,6 +157,8 @@ private:
 	const ModelType& model_;
 	const HamiltonianConnectionType& hc_;
 	SparseMatrixType matrixStored_;
+	RealType flops_;
+	RealType bytes_;
 }; // class MatrixVectorOnTheFly
 } // namespace Dmrg
 
@@ -83,6 +83,7 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include <vector>
 #include "ProgressIndicator.h"
 #include "MatrixVectorBase.h"
+#include "MatrixVectorEngineSelector.h"
 
 namespace Dmrg {
 template<typename ModelType_>
@@ -102,6 +103,7 @@ public:
 	typedef typename PsimagLite::Vector<RealType>::Type VectorRealType;
 	typedef PsimagLite::Matrix<ComplexOrRealType> FullMatrixType;
 	typedef typename ModelType::HamiltonianConnectionType HamiltonianConnectionType;
+	typedef MatrixVectorEngineSelector<ModelType> MatrixVectorEngineSelectorType;
 
 	MatrixVectorStored(const ModelType& model,
 	                   const HamiltonianConnectionType& hc,
@@ -109,8 +111,16 @@ public:
 	    : model_(model),
 	      matrixStored_(2),
 	      pointer_(0),
+	      flops_(0),
+	      bytes_(0),
 	      progress_("MatrixVectorStored")
 	{
+		if (MatrixVectorEngineSelectorType::needed(model)) {
+			MatrixVectorEngineSelectorType selector(model, hc);
+			flops_ = selector.flopsPerProduct(MatrixVectorEngineSelectorType::ENGINE_STORED);
+			bytes_ = selector.bytesKept(MatrixVectorEngineSelectorType::ENGINE_STORED);
+		}
+
 		PsimagLite::String options = model.params().options;
 		bool debugMatrix = (options.find("debugmatrix") != PsimagLite::String::npos);
 		if (!rs) {
@@ -136,6 +146,10 @@ public:
 
 	SizeType rows() const { return matrixStored_[pointer_].rows(); }
 
+	RealType flopsPerProduct() const { return flops_; }
+
+	RealType bytes() const { return bytes_; }
+
 	template<typename SomeVectorType>
 	void matrixVectorProduct(SomeVectorType &x, SomeVectorType const &y) const
 	{
@@ -164,6 +178,8 @@ private:
 	const ModelType& model_;
 	typename PsimagLite::Vector<SparseMatrixType>::Type matrixStored_;
 	SizeType pointer_;
+	RealType flops_;
+	RealType bytes_;
 	PsimagLite::ProgressIndicator progress_;
 }; // class MatrixVectorStored
 } // namespace Dmrg
@@ -88,6 +88,7 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include "ModelCommon.h"
 #include "NotReallySort.h"
 #include "ParallelHamiltonianConnection.h"
+#include "ParallelHamiltonianBlocks.h"
 
 namespace Dmrg {
 
@@ -134,6 +135,8 @@ public:
 	typedef PsimagLite::Vector<PsimagLite::String>::Type VectorStringType;
 	typedef typename ModelCommonType::VerySparseMatrixType VerySparseMatrixType;
 	typedef ParallelHamiltonianConnection<HamiltonianConnectionType> ParallelHamConnectionType;
+	typedef ParallelHamiltonianBlocks<HamiltonianConnectionType,
+	ModelLinksType> ParallelHamBlocksType;
 	typedef typename ModelLinksType::TermType ModelTermType;
 	typedef typename ModelLinksType::OpaqueOp OpForLinkType;
 
@@ -319,73 +322,32 @@ for (SizeType dof = 0; dof < numberOfDofs; ++dof) {
 		assert(lrs.super().partition() > 0);
 		SizeType total = lrs.super().partition()-1;
 
-		typename PsimagLite::Vector<VerySparseMatrixType*>::Type vvsm(total, 0);
-		VectorSizeType nzs(total, 0);
-
-		for (SizeType m = 0; m < total; ++m) {
-			SizeType offset = lrs.super().partition(m);
-			assert(lrs.super().partition(m + 1) >= offset);
-			SizeType bs = lrs.super().partition(m + 1) - offset;
-
-			vvsm[m] = new VerySparseMatrixType(bs, bs);
-			VerySparseMatrixType& vsm = *(vvsm[m]);
-			HamiltonianConnectionType hc(m,
-			                             lrs,
-			                             modelCommon_.geometry(),
-			                             modelLinks_,
-			                             currentTime,
-			                             0);
-
-			hc.matrixBond(vsm);
-			nzs[m] = vsm.nonZeros();
-			if (nzs[m] > 0) continue;
-			delete vvsm[m];
-			vvsm[m] = 0;
-		}
-
-		PsimagLite::Sort<VectorSizeType> sort;
-		VectorSizeType permutation(total, 0);
-		sort.sort(nzs, permutation);
-
-		typename PsimagLite::Vector<const SparseMatrixType*>::Type vectorOfCrs;
+		SizeType threads = std::min(total, PsimagLite::Concurrency::codeSectionParams.npthreads);
+		if (threads == 0) threads = 1;
 
-		assert(total == permutation.size());
-		for (SizeType i = 0; i < total; ++i) { // loop over new order
+		// links do not depend on the partition, so partition 0 builds
+		// the operators that all the threads below will read
+		HamiltonianConnectionType hc(0, lrs, modelCommon_.geometry(), modelLinks_, currentTime, 0);
+		hc.buildOperators();
 
-			SizeType m = permutation[i]; // get old index from new index
+		typedef PsimagLite::Parallelizer<ParallelHamBlocksType> ParallelizerType;
+		PsimagLite::CodeSectionParams codeSectionParams(threads);
+		ParallelizerType threadedBlocks(codeSectionParams);
 
-			if (vvsm[m] == 0) continue;
+		ParallelHamBlocksType phb(matrix,
+		                          lrs,
+		                          modelCommon_.geometry(),
+		                          modelLinks_,
+		                          currentTime,
+		                          threads);
+		threadedBlocks.loopCreate(phb); // counts the non-zeros of each partition
 
-			const VerySparseMatrixType& vsm = *(vvsm[m]);
-			SparseMatrixType matrixBlock2;
-			matrixBlock2 = vsm;
-			delete vvsm[m];
-			vvsm[m] = 0;
-
-			SizeType offset = lrs.super().partition(m);
-			SparseMatrixType* full = new SparseMatrixType(matrix.rows(),
-			                                              matrix.cols(),
-			                                              matrixBlock2.nonZeros());
-			fromBlockToFull(*full, matrixBlock2, offset);
-			vectorOfCrs.push_back(full);
-		}
-
-		if (vectorOfCrs.size() == 0) return;
-
-		vectorOfCrs.push_back(&matrix);
-		SizeType effectiveTotal = vectorOfCrs.size();
-
-		VectorType ones(effectiveTotal, 1.0);
-		SparseMatrixType sumCrs;
-		sum(sumCrs, vectorOfCrs, ones);
-		vectorOfCrs.pop_back();
-		effectiveTotal = vectorOfCrs.size();
-		for (SizeType i = 0; i < effectiveTotal; ++i) {
-			delete vectorOfCrs[i];
-			vectorOfCrs[i] = 0;
-		}
+		SparseMatrixType result;
+		phb.startFill(result);
+		threadedBlocks.loopCreate(phb); // writes each partition into result
 
-		matrix.swap(sumCrs);
+		result.checkValidity();
+		matrix.swap(result);
 	}
 
 	/** Let H be the hamiltonian of the  model for basis1 and partition m
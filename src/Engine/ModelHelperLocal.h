@@ -102,6 +102,7 @@ public:
 	typedef typename OperatorsType::BasisType BasisType;
 	typedef typename BasisType::BlockType BlockType;
 	typedef typename BasisType::RealType RealType;
+	typedef typename PsimagLite::Vector<RealType>::Type VectorRealType;
 	typedef typename LeftRightSuperType::BasisWithOperatorsType BasisWithOperatorsType;
 	typedef Link<SparseElementType> LinkType;
 	typedef typename PsimagLite::Vector<SparseElementType>::Type VectorSparseElementType;
@@ -367,6 +368,52 @@ public:
 		}
 	}
 
+	// Does d += diagonal of (AB) in partition m, computed entry by entry
+	// from the diagonals of A and B, without building (AB)
+	void fastOpProdInterDiagonal(VectorRealType& d,
+	                             const SparseMatrixType& A,
+	                             const SparseMatrixType& B,
+	                             const LinkType& link) const
+	{
+		RealType fermionSign = (link.fermionOrBoson == ProgramGlobals::FermionOrBosonEnum::FERMION)
+		        ? -1 : 1;
+
+		if (link.type==ProgramGlobals::ConnectionEnum::ENVIRON_SYSTEM)  {
+			LinkType link2 = link;
+			link2.value *= fermionSign;
+			link2.type = ProgramGlobals::ConnectionEnum::SYSTEM_ENVIRON;
+			fastOpProdInterDiagonal(d,B,A,link2);
+			return;
+		}
+
+		VectorSparseElementType diagA;
+		VectorSparseElementType diagB;
+		diagonalOf(diagA, A);
+		diagonalOf(diagB, B);
+
+		assert(d.size() == alpha_.size());
+		for (SizeType i = 0; i < d.size(); ++i) {
+			SparseElementType fsValue = (fermionSign < 0 && fermionSigns_[i])
+			        ? -link.value
+			        : link.value;
+			d[i] += PsimagLite::real(diagA[alpha_[i]]*diagB[beta_[i]]*fsValue);
+		}
+	}
+
+	// Does d += diagonal of the m-th block of
+	// basis2.hamiltonian_{alpha,alpha'} + basis2.hamiltonian_{beta,beta'}
+	void hamiltonianDiagonal(VectorRealType& d) const
+	{
+		VectorSparseElementType left;
+		VectorSparseElementType right;
+		diagonalOf(left, lrs_.left().hamiltonian());
+		diagonalOf(right, lrs_.right().hamiltonian());
+
+		assert(d.size() == alpha_.size());
+		for (SizeType i = 0; i < d.size(); ++i)
+			d[i] += PsimagLite::real(left[alpha_[i]] + right[beta_[i]]);
+	}
+
 	// if option==true let H_{alpha,beta; alpha',beta'} =
 	// basis2.hamiltonian_{alpha,alpha'} \delta_{beta,beta'}
 	// if option==false let  H_{alpha,beta; alpha',beta'} =
@@ -430,6 +477,17 @@ public:
 
 private:
 
+	static void diagonalOf(VectorSparseElementType& v, const SparseMatrixType& m)
+	{
+		v.assign(m.rows(), 0.0);
+		for (SizeType i = 0; i < m.rows(); ++i) {
+			for (int k = m.getRowPtr(i); k < m.getRowPtr(i + 1); ++k) {
+				if (static_cast<SizeType>(m.getCol(k)) != i) continue;
+				v[i] += m.getValue(k);
+			}
+		}
+	}
+
 	void createBuffer()
 	{
 		SizeType ns=lrs_.left().size();
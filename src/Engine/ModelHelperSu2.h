@@ -105,6 +105,7 @@ public:
 	typedef typename BasisType::QnType QnType;
 	typedef typename BasisType::BlockType BlockType;
 	typedef typename BasisType::RealType RealType;
+	typedef typename PsimagLite::Vector<RealType>::Type VectorRealType;
 	typedef typename SparseMatrixType::value_type SparseElementType;
 	typedef Link<SparseElementType> LinkType;
 	typedef typename PsimagLite::Vector<SparseElementType>::Type VectorSparseElementType;
@@ -380,6 +381,90 @@ public:
 		}
 	}
 
+	// Does d += diagonal of (AB) in partition m, computed entry by entry
+	// from the diagonals of A and B, without building (AB)
+	void fastOpProdInterDiagonal(VectorRealType& d,
+	                             SparseMatrixType const &A,
+	                             SparseMatrixType const &B,
+	                             const LinkType& link,
+	                             bool flipped=false) const
+	{
+		RealType fermionSign =  (link.fermionOrBoson == ProgramGlobals::FermionOrBosonEnum::FERMION)
+		        ? -1 : 1;
+
+		if (link.type == ProgramGlobals::ConnectionEnum::ENVIRON_SYSTEM)  {
+			LinkType link2 = link;
+			link2.value *= fermionSign;
+			link2.type = ProgramGlobals::ConnectionEnum::SYSTEM_ENVIRON;
+			fastOpProdInterDiagonal(d,B,A,link2,true);
+			return;
+		}
+
+		int offset = lrs_.super().partition(m_);
+		BlockType lElectrons;
+		lrs_.left().su2ElectronsBridge(lElectrons);
+		VectorSparseElementType diagA;
+		VectorSparseElementType diagB;
+		diagonalOf(diagA, A);
+		diagonalOf(diagB, B);
+
+		for (SizeType i=0;i<su2reduced_.reducedEffectiveSize();i++) {
+			int ix = su2reduced_.flavorMapping(i)-offset;
+			if (ix<0 || ix>=int(d.size())) continue;
+
+			SizeType i1=su2reduced_.reducedEffective(i).first;
+			SizeType i2=su2reduced_.reducedEffective(i).second;
+			if (diagA[i1] == static_cast<SparseElementType>(0) ||
+			        diagB[i2] == static_cast<SparseElementType>(0)) continue;
+
+			PairType jm1 = lrs_.left().jmValue(lrs_.left().reducedIndex(i1));
+			assert(lrs_.left().reducedIndex(i1) < lElectrons.size());
+			SizeType n1= lElectrons[lrs_.left().reducedIndex(i1)];
+			RealType fsign=1;
+			if (n1>0 && n1%2!=0) fsign= fermionSign;
+
+			PairType jm2 = lrs_.right().jmValue(lrs_.right().reducedIndex(i2));
+			SizeType lf1 =jm1.first + jm2.first*lrs_.left().jMax();
+
+			// the diagonal has i1prime = i1 and i2prime = i2, so lf2 = lf1
+			SparseElementType lfactor=su2reduced_.reducedFactor(link.angularMomentum,
+			                                                    link.category,
+			                                                    flipped,
+			                                                    lf1,
+			                                                    lf1);
+			if (lfactor==static_cast<SparseElementType>(0)) continue;
+			lfactor *= link.angularFactor;
+
+			d[ix] += PsimagLite::real(fsign*link.value*lfactor*diagA[i1]*diagB[i2]);
+		}
+	}
+
+	// Does d += diagonal of the m-th block of
+	// basis2.hamiltonian_{alpha,alpha'} + basis2.hamiltonian_{beta,beta'}
+	void hamiltonianDiagonal(VectorRealType& d) const
+	{
+		int offset = lrs_.super().partition(m_);
+		VectorSparseElementType left;
+		VectorSparseElementType right;
+		diagonalOf(left, su2reduced_.hamiltonianLeft());
+		diagonalOf(right, su2reduced_.hamiltonianRight());
+
+		for (SizeType i=0;i<su2reduced_.reducedEffectiveSize();i++) {
+			int ix = su2reduced_.flavorMapping(i)-offset;
+			if (ix<0 || ix>=int(d.size())) continue;
+
+			SizeType i1=su2reduced_.reducedEffective(i).first;
+			SizeType i2=su2reduced_.reducedEffective(i).second;
+			PairType jm1 = lrs_.left().jmValue(lrs_.left().reducedIndex(i1));
+			PairType jm2 = lrs_.right().jmValue(lrs_.right().reducedIndex(i2));
+			SparseElementType lfactor=su2reduced_.reducedHamiltonianFactor(jm1.first,
+			                                                               jm2.first);
+			if (lfactor==static_cast<SparseElementType>(0)) continue;
+
+			d[ix] += PsimagLite::real(left[i1] + right[i2]);
+		}
+	}
+
 	//! Note: USed only for debugging
 	void calcHamiltonianPartLeft(SparseMatrixType &matrixBlock) const
 	{
@@ -478,6 +563,17 @@ public:
 
 private:
 
+	static void diagonalOf(VectorSparseElementType& v, const SparseMatrixType& m)
+	{
+		v.assign(m.rows(), 0.0);
+		for (SizeType i = 0; i < m.rows(); ++i) {
+			for (int k = m.getRowPtr(i); k < m.getRowPtr(i + 1); ++k) {
+				if (static_cast<SizeType>(m.getCol(k)) != i) continue;
+				v[i] += m.getValue(k);
+			}
+		}
+	}
+
 	int m_;
 	const LeftRightSuperType&  lrs_;
 	Su2Reduced<LeftRightSuperType> su2reduced_;
@@ -83,6 +83,8 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include "Vector.h"
 #include "ProgramGlobals.h"
 #include "ApplyOperatorLocal.h"
+#include "CorrelationsStream.h"
+#include "Parallelizer.h"
 
 namespace Dmrg {
 
@@ -105,8 +107,16 @@ public:
 	typedef PsimagLite::Matrix<FieldType> MatrixType;
 	typedef typename PsimagLite::Vector<MatrixType>::Type VectorMatrixType;
 	typedef typename ObserverType::BraketType BraketType;
+	typedef typename PsimagLite::Vector<BraketType>::Type VectorBraketType;
+	typedef typename PsimagLite::Vector<const BraketType*>::Type VectorConstBraketPtrType;
+	typedef typename BraketType::VectorStringType VectorStringType;
 	typedef PsimagLite::Vector<SizeType>::Type VectorSizeType;
+	typedef PsimagLite::Vector<bool>::Type VectorBoolType;
+	typedef typename PsimagLite::Vector<SparseMatrixType>::Type VectorSparseMatrixType;
+	typedef typename ObserverType::VectorTwoPointItemType VectorTwoPointItemType;
+	typedef typename ObserverType::TwoPointItemType TwoPointItemType;
 	typedef std::pair<SizeType,SizeType> PairSizeType;
+	typedef CorrelationsStream<FieldType> CorrelationsStreamType;
 
 	template<typename IoInputter>
 	ObservableLibrary(IoInputter& io,
@@ -117,161 +127,188 @@ public:
 	                  SizeType trail)
 	    : numberOfSites_(numberOfSites),
 	      model_(model),
-	      observe_(io, start, nf, trail, model.params())
+	      observe_(io, start, nf, trail, model.params()),
+	      stream_(model.params().filename,
+	              model.params().options.find("observeStream") != PsimagLite::String::npos)
 	{}
 
 	bool endOfData() const { return observe_.helper().endOfData(); }
 
 	const ModelType& model() const { return model_; }
 
-	void interpret(const PsimagLite::String& list, SizeType rows, SizeType cols)
+	void interpret(const PsimagLite::String& list,
+	               SizeType rows,
+	               SizeType cols,
+	               SizeType orbitals)
 	{
-		typename BraketType::VectorStringType vecStr;
+		VectorStringType vecStr;
 		PsimagLite::split(vecStr, list, ",");
+		interpret(vecStr, rows, cols, orbitals);
+	}
 
-		for (SizeType i = 0; i < vecStr.size(); ++i) {
-			BraketType braket(model_, vecStr[i]);
-
-			if (braket.points() == 1) {
-				measureOnePoint(braket.bra(),
-				                braket.op(0),
-				                braket.opName(0),
-				                braket.ket());
+	// Measures all items, brakets or labels of measure(), printing them
+	// in the order given.
+	// One-point brakets are measured together, each step used for all of
+	// them before the next step, with the brakets split among threads.
+	// Two-point brakets without sites and the two-point labels cc, dd, nn,
+	// szsz, s+s- and s-s+ are measured together, unless streamed, each pair
+	// of sites for all of them, with the pairs split among threads.
+	// Other brakets and labels are measured one by one.
+	void interpret(const VectorStringType& items,
+	               SizeType rows,
+	               SizeType cols,
+	               SizeType orbitals)
+	{
+		// brakets of item i are firstBraket[i] to firstBraket[i + 1];
+		// grouped is false for a label measured by measure() in its place
+		VectorBraketType brakets;
+		VectorSizeType firstBraket(items.size() + 1, 0);
+		VectorBoolType grouped(items.size(), true);
+		VectorSparseMatrixType nnOps;
+		VectorSizeType firstNn(items.size() + 1, 0);
+		for (SizeType i = 0; i < items.size(); ++i) {
+			firstBraket[i] = brakets.size();
+			firstNn[i] = nnOps.size()/2;
+			if (!isLabel(items[i])) {
+				brakets.push_back(BraketType(model_, items[i]));
 				continue;
 			}
 
-			manyPoint(0,braket,rows,cols);
-		}
-	}
-
-	void measure(const PsimagLite::String& label,
-	             SizeType rows,
-	             SizeType cols,
-	             SizeType orbitals)
-	{
-		// FIXME: No support for site varying operators
-		if (label=="cc") {
-			BraketType braket(model_,"<gs|c?0-;c'?0-|gs>");
-			manyPoint(0,braket,rows,cols); // c_{0,0} spin down
-			BraketType braket2(model_,"<gs|c?1-;c'?1-|gs>");
-			manyPoint(0,braket2,rows,cols); // c_{0,0} spin down
-		} else if (label=="nn") {
-			MatrixType out(rows,cols);
-			SizeType site = 1;
-			for (SizeType i = 0; i < orbitals*2; ++i) {
-				for (SizeType j = i; j < orbitals*2; ++j) {
-					SparseMatrixType O2,O4,n1,n2;
-					SparseMatrixType O1 = model_.naturalOperator("c",site,i).data; // c_i
-					transposeConjugate(O2,O1); // O2 = transpose(O1)
-					SparseMatrixType O3 = model_.naturalOperator("c",site,j).data; // c_j
-					transposeConjugate(O4,O3); // O4 = transpose(O3)
-
-					multiply(n1,O2,O1); // c_i^{\dagger}.c_i
-					multiply(n2,O4,O3); // c_j^{\dagger}.c_j
-
-					PsimagLite::String str = "<gs|n?" + ttos(i) + ";n?" + ttos(j) + "|gs>";
-					observe_.twoPoint(out,
-					                  n1,
-					                  n2,
-					                  ProgramGlobals::FermionOrBosonEnum::BOSON,
-					                  "gs",
-					                  "gs");
-					std::cout << str << std::endl;
-					std::cout << out;
-				}
+			if (items[i] == "nn" && !stream_.enabled()) {
+				nnOperators(nnOps, orbitals);
+				continue;
 			}
 
-		} else if (label=="szsz") {
-			resizeStorage(szsz_,rows,cols,orbitals);
-			MatrixType tSzTotal;
-			SizeType counter = 0;
-			for (SizeType i = 0; i < orbitals; ++i) {
-				for (SizeType j = i; j < orbitals; ++j) {
-					PsimagLite::String str = "<gs|sz?" + ttos(i) + ";sz?" + ttos(j) + "|gs>";
-					BraketType braket(model_,str);
-					manyPoint(&szsz_[counter],braket,rows,cols);
-					MatrixType tSzThis = szsz_[counter];
-					RealType factor = (i != j) ? 2.0 : 1.0;
-					if (counter == 0)
-						tSzTotal =  factor*tSzThis;
-					else
-						tSzTotal +=  factor*tSzThis;
+			// labels made of brakets; streamed, they are measured in place, as brakets are
+			VectorStringType strs;
+			labelBrakets(strs, items[i], orbitals);
+			grouped[i] = (strs.size() > 0 && !stream_.enabled());
+			if (!grouped[i]) continue;
 
-					if (PsimagLite::Concurrency::root()) {
-						std::cout<<"OperatorSz orb"<<i<<"-"<<j<<":\n";
-						std::cout<<tSzThis;
-					}
-					counter++;
-				}
-			}
+			for (SizeType x = 0; x < strs.size(); ++x)
+				brakets.push_back(BraketType(model_, strs[x]));
+		}
 
-			if (PsimagLite::Concurrency::root() && orbitals > 1) {
-				std::cout<<"OperatorSz tot:\n";
-				std::cout<<tSzTotal;
+		firstBraket[items.size()] = brakets.size();
+		firstNn[items.size()] = nnOps.size()/2;
+
+		VectorConstBraketPtrType onePoints;
+		VectorConstBraketPtrType twoPoints;
+		VectorSizeType slots(brakets.size(), 0);
+		for (SizeType i = 0; i < brakets.size(); ++i) {
+			const BraketType& braket = brakets[i];
+			if (braket.points() == 1) {
+				slots[i] = onePoints.size();
+				onePoints.push_back(&braket);
+			} else if (braket.points() == 2 &&
+			           !stream_.enabled() &&
+			           ObserverType::hasNoSites(braket)) {
+				slots[i] = twoPoints.size();
+				twoPoints.push_back(&braket);
 			}
+		}
 
-		} else if (label=="s+s-") {
-			// Si^+ Sj^-
-			resizeStorage(sPlusSminus_,rows,cols,orbitals);
-			MatrixType tSpTotal;
-			SizeType counter = 0;
-			for (SizeType i = 0; i < orbitals; ++i) {
-				for (SizeType j = i; j < orbitals; ++j) {
-					PsimagLite::String str = "<gs|splus?" + ttos(i) + ";sminus?" + ttos(j) + "|gs>";
-					BraketType braket(model_,str);
-					manyPoint(&sPlusSminus_[counter],braket,rows,cols);
-					MatrixType tSpThis = sPlusSminus_[counter];
-					RealType factor = (i != j) ? 2.0 : 1.0;
-					if (counter == 0)
-						tSpTotal =  factor*tSpThis;
-					else
-						tSpTotal +=  factor*tSpThis;
+		VectorStringType onePointTexts;
+		measureOnePoints(onePointTexts, onePoints);
+
+		// one pass for the two-point brakets and the correlations of nn
+		VectorMatrixType twoPointMatrices(twoPoints.size());
+		VectorMatrixType nnMatrices(nnOps.size()/2);
+		VectorTwoPointItemType twoPointItems;
+		for (SizeType x = 0; x < twoPoints.size(); ++x)
+			twoPointItems.push_back(ObserverType::twoPointItem(twoPointMatrices[x],
+			                                                   *twoPoints[x],
+			                                                   rows,
+			                                                   cols));
+
+		for (SizeType x = 0; x < nnMatrices.size(); ++x) {
+			nnMatrices[x].resize(rows, cols);
+			nnMatrices[x].setTo(0.0);
+			twoPointItems.push_back(TwoPointItemType(nnMatrices[x],
+			                                         nnOps[2*x],
+			                                         nnOps[2*x + 1],
+			                                         ProgramGlobals::FermionOrBosonEnum::BOSON,
+			                                         "gs",
+			                                         "gs"));
+		}
 
+		if (twoPointItems.size() > 0)
+			observe_.twoPoint(twoPointItems, rows, cols);
 
-					if (PsimagLite::Concurrency::root()) {
-						std::cout<<"OperatorS+S- orb"<<i<<"-"<<j<<":\n";
-						std::cout<<tSpTotal;
-					}
-					counter++;
-				}
+		for (SizeType i = 0; i < items.size(); ++i) {
+			if (!grouped[i]) {
+				measure(items[i], rows, cols, orbitals);
+				continue;
 			}
 
-			if (PsimagLite::Concurrency::root() && orbitals > 1) {
-				std::cout<<"OperatorS+S- tot:\n";
-				std::cout<<tSpTotal;
+			if (firstNn[i + 1] > firstNn[i]) {
+				printNn(nnMatrices, firstNn[i], orbitals);
+				continue;
 			}
 
-		} else if (label=="s-s+") {
-			// Si^- Sj^+
-			resizeStorage(sMinusSplus_,rows,cols,orbitals);
-			MatrixType tSmTotal;
-			SizeType counter = 0;
-			for (SizeType i = 0; i < orbitals; ++i) {
-				for (SizeType j = i; j < orbitals; ++j) {
-					PsimagLite::String str = "<gs|sminus?" + ttos(i) + ";splus?" + ttos(j) + "|gs>";
-					BraketType braket(model_,str);
-					manyPoint(&sMinusSplus_[counter],braket,rows,cols);
-					MatrixType tSmThis = sMinusSplus_[counter];
-					RealType factor = (i != j) ? 2.0 : 1.0;
-					if (counter == 0)
-						tSmTotal =  factor*tSmThis;
-					else
-						tSmTotal +=  factor*tSmThis;
+			VectorMatrixType* storage = orbitalStorage(items[i]);
+			if (storage) {
+				resizeStorage(*storage, rows, cols, orbitals);
+				for (SizeType x = firstBraket[i]; x < firstBraket[i + 1]; ++x)
+					(*storage)[x - firstBraket[i]] = twoPointMatrices[slots[x]];
 
+				printOrbitalPairs(items[i], *storage, &brakets[firstBraket[i]], orbitals);
+				continue;
+			}
 
-					if (PsimagLite::Concurrency::root()) {
-						std::cout<<"OperatorS-S+ orb"<<i<<"-"<<j<<":\n";
-						std::cout<<tSmTotal;
-					}
-					counter++;
+			for (SizeType x = firstBraket[i]; x < firstBraket[i + 1]; ++x) {
+				const BraketType& braket = brakets[x];
+				if (braket.points() == 1) {
+					std::cout<<onePointTexts[slots[x]];
+				} else if (slots[x] < twoPoints.size() && twoPoints[slots[x]] == &braket) {
+					printHeader(braket);
+					std::cout<<twoPointMatrices[slots[x]];
+				} else {
+					manyPoint(0, braket, rows, cols);
 				}
 			}
+		}
+	}
 
-			if (PsimagLite::Concurrency::root() && orbitals > 1) {
-				std::cout<<"OperatorS-S+ tot:\n";
-				std::cout<<tSmTotal;
+	void measure(const PsimagLite::String& label,
+	             SizeType rows,
+	             SizeType cols,
+	             SizeType orbitals)
+	{
+		// FIXME: No support for site varying operators
+		if (label=="cc" || label=="dd") {
+			VectorStringType strs;
+			labelBrakets(strs, label, orbitals);
+			for (SizeType x = 0; x < strs.size(); ++x) {
+				BraketType braket(model_, strs[x]);
+				manyPoint(0, braket, rows, cols);
+			}
+		} else if (label=="nn") {
+			VectorSparseMatrixType nnOps;
+			nnOperators(nnOps, orbitals);
+			VectorMatrixType out(nnOps.size()/2, MatrixType(rows, cols));
+			for (SizeType x = 0; x < out.size(); ++x)
+				observe_.twoPoint(out[x],
+				                  nnOps[2*x],
+				                  nnOps[2*x + 1],
+				                  ProgramGlobals::FermionOrBosonEnum::BOSON,
+				                  "gs",
+				                  "gs");
+
+			printNn(out, 0, orbitals);
+		} else if (orbitalStorage(label)) {
+			// szsz, s+s- or s-s+
+			VectorMatrixType& storage = *orbitalStorage(label);
+			resizeStorage(storage, rows, cols, orbitals);
+			VectorStringType strs;
+			labelBrakets(strs, label, orbitals);
+			VectorBraketType brakets;
+			for (SizeType x = 0; x < strs.size(); ++x) {
+				brakets.push_back(BraketType(model_, strs[x]));
+				observe_.twoPoint(storage[x], brakets[x]);
 			}
 
+			printOrbitalPairs(label, storage, &brakets[0], orbitals);
 		} else if (label=="ss") {
 			MatrixType spinTotalTotal;
 			SizeType counter = 0;
@@ -314,11 +351,6 @@ public:
 				std::cout<<spinTotalTotal;
 			}
 
-		} else if (label=="dd") {
-
-			BraketType braket(model_,"<gs|d;d'|gs>");
-			manyPoint(0,braket,rows,cols);
-
 		} else if (label == "pp") {
 			if (model_.params().model!="TjMultiOrb" &&
 			        model_.params().model!="HubbardOneBandExtendedSuper") {
@@ -377,36 +409,118 @@ public:
 
 private:
 
-	void measureOnePoint(const PsimagLite::String& bra,
-	                     const OperatorType& opA,
-	                     PsimagLite::String label,
-	                     const PsimagLite::String& ket)
+	// the text of each one-point braket, measured in one pass over the steps
+	// the one-point brakets at step i0, one braket per task
+	class ParallelOnePoints {
+
+	public:
+
+		typedef typename PsimagLite::Vector<PsimagLite::OstringStream*>::Type
+		VectorOstringStreamPtrType;
+
+		ParallelOnePoints(ObservableLibrary& library,
+		                  const VectorConstBraketPtrType& brakets,
+		                  VectorOstringStreamPtrType& os,
+		                  bool inThreads)
+		    : library_(library), brakets_(brakets), os_(os), inThreads_(inThreads), i0_(0)
+		{}
+
+		void step(SizeType i0) { i0_ = i0; }
+
+		void doTask(SizeType x, SizeType)
+		{
+			const BraketType& braket = *brakets_[x];
+			library_.measureOnePoint(*os_[x],
+			                         i0_,
+			                         braket.bra(),
+			                         braket.op(0),
+			                         braket.opName(0),
+			                         braket.ket(),
+			                         inThreads_);
+		}
+
+		SizeType tasks() const { return brakets_.size(); }
+
+	private:
+
+		ObservableLibrary& library_;
+		const VectorConstBraketPtrType& brakets_;
+		VectorOstringStreamPtrType& os_;
+		bool inThreads_;
+		SizeType i0_;
+	}; // class ParallelOnePoints
+
+	void measureOnePoints(VectorStringType& texts, const VectorConstBraketPtrType& brakets)
 	{
-		for (SizeType i0 = 0; i0 < observe_.helper().size(); ++i0) {
+		const SizeType n = brakets.size();
+		typename ParallelOnePoints::VectorOstringStreamPtrType os(n);
+		for (SizeType x = 0; x < n; ++x) {
+			os[x] = new PsimagLite::OstringStream();
+			os[x]->precision(std::cout.precision());
+		}
 
-			if (i0==0) {
-				std::cout<<"Using Matrix A:\n";
-				std::cout<<opA.data.toDense();
-				std::cout<<"site <"<<bra<<"|"<<label;
-				std::cout<<"|"<<ket<<"> time\n";
+		// brakets are split among threads; a single braket uses them
+		// to apply its operator instead
+		const bool inThreads = (n > 1 && PsimagLite::Concurrency::codeSectionParams.npthreads > 1);
+		ParallelOnePoints helper(*this, brakets, os, inThreads);
+		PsimagLite::Parallelizer<ParallelOnePoints> threadedOnePoints(
+		            PsimagLite::Concurrency::codeSectionParams);
+		for (SizeType i0 = 0; i0 < observe_.helper().size(); ++i0) {
+			helper.step(i0);
+			if (inThreads) {
+				threadedOnePoints.loopCreate(helper);
+				continue;
 			}
 
-			cornerLeftOrRight(1, i0, bra, opA, ket);
+			for (SizeType x = 0; x < n; ++x)
+				helper.doTask(x, 0);
+		}
 
-			FieldType tmp1 = observe_.template
-			        onePoint<ApplyOperatorType>(i0, opA, ApplyOperatorType::BORDER_NO, bra, ket);
-			std::cout<<observe_.helper().site(i0)<<" "<<tmp1;
-			std::cout<<" "<<observe_.helper().time(i0)<<"\n";
+		texts.resize(n);
+		for (SizeType x = 0; x < n; ++x) {
+			texts[x] = os[x]->str();
+			delete os[x];
+			os[x] = 0;
+		}
+	}
 
-			cornerLeftOrRight(numberOfSites_ - 2, i0, bra, opA, ket);
+	void measureOnePoint(std::ostream& os,
+	                     SizeType i0,
+	                     const PsimagLite::String& bra,
+	                     const OperatorType& opA,
+	                     PsimagLite::String label,
+	                     const PsimagLite::String& ket,
+	                     bool inThreads)
+	{
+		if (i0==0) {
+			os<<"Using Matrix A:\n";
+			os<<opA.data.toDense();
+			os<<"site <"<<bra<<"|"<<label;
+			os<<"|"<<ket<<"> time\n";
 		}
+
+		cornerLeftOrRight(os, 1, i0, bra, opA, ket, inThreads);
+
+		FieldType tmp1 = observe_.template
+		        onePoint<ApplyOperatorType>(i0,
+		                                    opA,
+		                                    ApplyOperatorType::BORDER_NO,
+		                                    bra,
+		                                    ket,
+		                                    inThreads);
+		os<<observe_.helper().site(i0)<<" "<<tmp1;
+		os<<" "<<observe_.helper().time(i0)<<"\n";
+
+		cornerLeftOrRight(os, numberOfSites_ - 2, i0, bra, opA, ket, inThreads);
 	}
 
-	void cornerLeftOrRight(SizeType site,
+	void cornerLeftOrRight(std::ostream& os,
+	                       SizeType site,
 	                       SizeType ptr,
 	                       const PsimagLite::String& bra,
 	                       const OperatorType& opA,
-	                       const PsimagLite::String& ket)
+	                       const PsimagLite::String& ket,
+	                       bool inThreads)
 	{
 		if (observe_.helper().site(ptr) != site) return;
 
@@ -416,8 +530,9 @@ private:
 			FieldType tmp1 = observe_.template onePointHookForZero<ApplyOperatorType>(ptr,
 			                                                                          opA,
 			                                                                          bra,
-			                                                                          ket);
-			std::cout<<"0 "<<tmp1<<" "<<observe_.helper().time(ptr)<<"\n";
+			                                                                          ket,
+			                                                                          inThreads);
+			os<<"0 "<<tmp1<<" "<<observe_.helper().time(ptr)<<"\n";
 			return;
 		}
 
@@ -436,9 +551,10 @@ private:
 		                                    opAcorner,
 		                                    ApplyOperatorType::BORDER_YES,
 		                                    bra,
-		                                    ket);
-		std::cout<<x<<" "<<tmp1;
-		std::cout<<" "<<observe_.helper().time(ptr)<<"\n";
+		                                    ket,
+		                                    inThreads);
+		os<<x<<" "<<tmp1;
+		os<<" "<<observe_.helper().time(ptr)<<"\n";
 	}
 
 	MatrixType SliceOrbital(const MatrixType& m,
@@ -1115,14 +1231,17 @@ private:
 	               SizeType rows,
 	               SizeType cols)
 	{
-		if (hasTimeEvolution_) {
-			printSites();
-			std::cout<<"Time="<<observe_.helper().time(0)<<"\n";
-		}
-
-		std::cout<<braket.toString()<<"\n";
+		printHeader(braket);
 
 		if (braket.points() == 2) {
+			if (storage == 0 && stream_.enabled()) {
+				PsimagLite::String label = braket.toString();
+				label += " time=" + ttos(observe_.helper().time(0));
+				observe_.twoPoint(stream_, label, braket, rows, cols);
+				std::cout<<"written to "<<stream_.filename()<<"\n";
+				return;
+			}
+
 			bool needsPrinting = false;
 			if (storage == 0) {
 				needsPrinting = true;
@@ -1150,6 +1269,16 @@ private:
 		observe_.anyPoint(braket);
 	}
 
+	void printHeader(const BraketType& braket) const
+	{
+		if (hasTimeEvolution_) {
+			printSites();
+			std::cout<<"Time="<<observe_.helper().time(0)<<"\n";
+		}
+
+		std::cout<<braket.toString()<<"\n";
+	}
+
 	void resizeStorage(VectorMatrixType& v,
 	                   SizeType rows,
 	                   SizeType cols,
@@ -1161,6 +1290,132 @@ private:
 			v[i].resize(rows,cols);
 	}
 
+	static bool isLabel(const PsimagLite::String& item)
+	{
+		return (item.length() > 0 && item[0] != '<');
+	}
+
+	// the brakets of the labels cc, dd, szsz, s+s- and s-s+ of measure();
+	// none for other labels
+	static void labelBrakets(VectorStringType& strs,
+	                         const PsimagLite::String& label,
+	                         SizeType orbitals)
+	{
+		strs.clear();
+		if (label == "cc") {
+			strs.push_back("<gs|c?0-;c'?0-|gs>"); // c_{0,0} spin down
+			strs.push_back("<gs|c?1-;c'?1-|gs>");
+			return;
+		}
+
+		if (label == "dd") {
+			strs.push_back("<gs|d;d'|gs>");
+			return;
+		}
+
+		PsimagLite::String op1;
+		PsimagLite::String op2;
+		if (label == "szsz") {
+			op1 = op2 = "sz";
+		} else if (label == "s+s-") {
+			// Si^+ Sj^-
+			op1 = "splus";
+			op2 = "sminus";
+		} else if (label == "s-s+") {
+			// Si^- Sj^+
+			op1 = "sminus";
+			op2 = "splus";
+		} else {
+			return;
+		}
+
+		for (SizeType i = 0; i < orbitals; ++i)
+			for (SizeType j = i; j < orbitals; ++j)
+				strs.push_back("<gs|" + op1 + "?" + ttos(i) + ";" + op2 + "?" + ttos(j) + "|gs>");
+	}
+
+	// the storage that ss uses for szsz, s+s- or s-s+; 0 for other labels
+	VectorMatrixType* orbitalStorage(const PsimagLite::String& label)
+	{
+		if (label == "szsz") return &szsz_;
+		if (label == "s+s-") return &sPlusSminus_;
+		if (label == "s-s+") return &sMinusSplus_;
+		return 0;
+	}
+
+	// prints szsz, s+s- or s-s+ from storage, one matrix per pair of orbitals,
+	// then their total; s+s- and s-s+ print the total so far for each pair
+	void printOrbitalPairs(const PsimagLite::String& label,
+	                       const VectorMatrixType& storage,
+	                       const BraketType* brakets,
+	                       SizeType orbitals) const
+	{
+		PsimagLite::String name("OperatorSz");
+		if (label == "s+s-") name = "OperatorS+S-";
+		else if (label == "s-s+") name = "OperatorS-S+";
+
+		const bool printTotal = (label != "szsz");
+		MatrixType total;
+		SizeType counter = 0;
+		for (SizeType i = 0; i < orbitals; ++i) {
+			for (SizeType j = i; j < orbitals; ++j) {
+				printHeader(brakets[counter]);
+				RealType factor = (i != j) ? 2.0 : 1.0;
+				if (counter == 0)
+					total = factor*storage[counter];
+				else
+					total += factor*storage[counter];
+
+				if (PsimagLite::Concurrency::root()) {
+					std::cout<<name<<" orb"<<i<<"-"<<j<<":\n";
+					std::cout<<((printTotal) ? total : storage[counter]);
+				}
+
+				counter++;
+			}
+		}
+
+		if (PsimagLite::Concurrency::root() && orbitals > 1) {
+			std::cout<<name<<" tot:\n";
+			std::cout<<total;
+		}
+	}
+
+	// n_i and n_j, one after the other, for each pair i <= j of the
+	// orbitals and spins of nn
+	void nnOperators(VectorSparseMatrixType& ops, SizeType orbitals) const
+	{
+		SizeType site = 1;
+		for (SizeType i = 0; i < orbitals*2; ++i) {
+			for (SizeType j = i; j < orbitals*2; ++j) {
+				SparseMatrixType O2,O4,n1,n2;
+				SparseMatrixType O1 = model_.naturalOperator("c",site,i).data; // c_i
+				transposeConjugate(O2,O1); // O2 = transpose(O1)
+				SparseMatrixType O3 = model_.naturalOperator("c",site,j).data; // c_j
+				transposeConjugate(O4,O3); // O4 = transpose(O3)
+
+				multiply(n1,O2,O1); // c_i^{\dagger}.c_i
+				multiply(n2,O4,O3); // c_j^{\dagger}.c_j
+
+				ops.push_back(n1);
+				ops.push_back(n2);
+			}
+		}
+	}
+
+	// prints nn from out, starting at its matrix first
+	void printNn(const VectorMatrixType& out, SizeType first, SizeType orbitals) const
+	{
+		SizeType counter = first;
+		for (SizeType i = 0; i < orbitals*2; ++i) {
+			for (SizeType j = i; j < orbitals*2; ++j) {
+				PsimagLite::String str = "<gs|n?" + ttos(i) + ";n?" + ttos(j) + "|gs>";
+				std::cout << str << std::endl;
+				std::cout << out[counter++];
+			}
+		}
+	}
+
 	SizeType logBase2(SizeType x) const
 	{
 		SizeType counter = 0;
@@ -1211,6 +1466,7 @@ private:
 	const ModelType& model_; // not the owner
 	ObserverType observe_;
 	VectorMatrixType szsz_,sPlusSminus_,sMinusSplus_;
+	CorrelationsStreamType stream_;
 
 }; // class ObservableLibrary
 
@@ -118,6 +118,8 @@ public:
 	typedef ModelType_ ModelType;
 	typedef VectorWithOffsetType_ VectorWithOffsetType;
 	typedef Parallel4PointDs<ModelType,FourPointCorrelationsType> Parallel4PointDsType;
+	typedef typename TwoPointCorrelationsType::VectorItemType VectorTwoPointItemType;
+	typedef typename VectorTwoPointItemType::value_type TwoPointItemType;
 
 	Observer(IoInputType& io,
 	         SizeType start,
@@ -128,9 +130,11 @@ public:
 	              start,
 	              nf,
 	              trail,
-	              params.options.find("fixLegacyBugs") == PsimagLite::String::npos),
-	      onepoint_(helper_),
-	      skeleton_(helper_, true),
+	              params.options.find("fixLegacyBugs") == PsimagLite::String::npos,
+	              params.observeMemoryBudget),
+	      onepoint_(helper_, PsimagLite::Concurrency::codeSectionParams.npthreads),
+	      onepointInThreads_(helper_, 1),
+	      skeleton_(helper_, true, PsimagLite::Concurrency::codeSectionParams.npthreads),
 	      twopoint_(skeleton_),
 	      fourpoint_(skeleton_)
 	{}
@@ -201,6 +205,97 @@ public:
 		}
 	}
 
+	// As twoPoint(storage, braket) but, if no sites are given, with
+	// a few rows at a time, each written to stream as soon as it is done;
+	// rows already in stream are skipped
+	template<typename CorrelationsStreamType>
+	void twoPoint(CorrelationsStreamType& stream,
+	              PsimagLite::String label,
+	              const BraketType& braket,
+	              SizeType rows,
+	              SizeType cols) const
+	{
+		if (!hasNoSites(braket)) {
+			MatrixType storage(rows, cols);
+			twoPoint(storage, braket);
+			stream.write(label, storage, 0);
+			return;
+		}
+
+		const SizeType chunk = std::max(PsimagLite::Concurrency::codeSectionParams.npthreads,
+		                                static_cast<SizeType>(1));
+		for (SizeType offset = 0; offset < rows; offset += chunk) {
+			const SizeType n = std::min(chunk, rows - offset);
+			bool done = true;
+			for (SizeType i = 0; i < n; ++i)
+				if (!stream.hasRow(label, offset + i)) done = false;
+
+			if (done) continue;
+
+			MatrixType buffer(n, cols);
+			twopoint_.fillRows(buffer,
+			                   offset,
+			                   braket.op(0).data,
+			                   braket.op(1).data,
+			                   braket.op(0).fermionOrBoson,
+			                   braket.bra(),
+			                   braket.ket());
+			stream.write(label, buffer, offset);
+		}
+	}
+
+	// As twoPoint(storage, braket) for many brakets without sites,
+	// each pair of sites computed for all of them in turn
+	void twoPoint(VectorMatrixType& storages,
+	              const typename PsimagLite::Vector<const BraketType*>::Type& brakets,
+	              SizeType rows,
+	              SizeType cols) const
+	{
+		storages.resize(brakets.size());
+		VectorTwoPointItemType items;
+		for (SizeType x = 0; x < brakets.size(); ++x)
+			items.push_back(twoPointItem(storages[x], *brakets[x], rows, cols));
+
+		twoPoint(items, rows, cols);
+	}
+
+	// As twoPoint(m, O1, O2, ...) for many correlations, each given by its
+	// matrix, already of rows times cols, its operators, and its bra and ket
+	void twoPoint(const VectorTwoPointItemType& items, SizeType rows, SizeType cols) const
+	{
+		twopoint_(items, rows, cols);
+	}
+
+	// the item of twoPoint(items, ...) for braket, which has no sites,
+	// with storage resized and zeroed
+	static TwoPointItemType twoPointItem(MatrixType& storage,
+	                                     const BraketType& braket,
+	                                     SizeType rows,
+	                                     SizeType cols)
+	{
+		assert(braket.points() == 2 && hasNoSites(braket));
+		storage.resize(rows, cols);
+		storage.setTo(0.0);
+		return TwoPointItemType(storage,
+		                        braket.op(0).data,
+		                        braket.op(1).data,
+		                        braket.op(0).fermionOrBoson,
+		                        braket.bra(),
+		                        braket.ket());
+	}
+
+	static bool hasNoSites(const BraketType& braket)
+	{
+		for (SizeType i = 0; i < braket.points(); ++i) {
+			try {
+				braket.site(i);
+				return false;
+			} catch (std::exception&) {}
+		}
+
+		return true;
+	}
+
 	void twoPoint(MatrixType& m,
 	              const SparseMatrixType& O1,
 	              const SparseMatrixType& O2,
@@ -463,8 +558,11 @@ public:
 		typedef PsimagLite::Parallelizer<Parallel4PointDsType> ParallelizerType;
 		ParallelizerType threaded4PointDs(PsimagLite::Concurrency::codeSectionParams);
 
+		// brackets run inside the threads of this loop
+		const CorrelationsSkeletonType skeletonInThreads(skeleton_, 1);
+		const FourPointCorrelationsType fourpointInThreads(skeletonInThreads);
 		Parallel4PointDsType helper4PointDs(fpd,
-		                                    fourpoint_,
+		                                    fourpointInThreads,
 		                                    model,
 		                                    gammas,
 		                                    pairs,
@@ -473,23 +571,29 @@ public:
 		threaded4PointDs.loopCreate(helper4PointDs);
 	}
 
+	// inThreads must be true when called inside a parallel loop, so that
+	// the operator is applied with one thread
 	template<typename ApplyOperatorType>
 	FieldType onePoint(SizeType site,
 	                   const typename ApplyOperatorType::OperatorType& A,
 	                   typename ApplyOperatorType::BorderEnum corner,
 	                   PsimagLite::String bra,
-	                   PsimagLite::String ket) const
+	                   PsimagLite::String ket,
+	                   bool inThreads = false) const
 	{
-		return onepoint_.template operator()<ApplyOperatorType>(site, A, corner, bra, ket);
+		const OnePointCorrelationsType& onepoint = (inThreads) ? onepointInThreads_ : onepoint_;
+		return onepoint.template operator()<ApplyOperatorType>(site, A, corner, bra, ket);
 	}
 
 	template<typename ApplyOperatorType>
 	FieldType onePointHookForZero(SizeType site,
 	                              const typename ApplyOperatorType::OperatorType& A,
 	                              PsimagLite::String bra,
-	                              PsimagLite::String ket) const
+	                              PsimagLite::String ket,
+	                              bool inThreads = false) const
 	{
-		return onepoint_.template hookForZero<ApplyOperatorType>(site, A, bra, ket);
+		const OnePointCorrelationsType& onepoint = (inThreads) ? onepointInThreads_ : onepoint_;
+		return onepoint.template hookForZero<ApplyOperatorType>(site, A, bra, ket);
 	}
 
 	template<typename VectorLikeType>
@@ -510,6 +614,7 @@ private:
 
 	const ObserverHelperType helper_;
 	const OnePointCorrelationsType onepoint_;
+	const OnePointCorrelationsType onepointInThreads_;
 	const CorrelationsSkeletonType skeleton_;
 	const TwoPointCorrelationsType twopoint_;
 	const FourPointCorrelationsType fourpoint_;
@@ -85,9 +85,22 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include "VectorWithOffsets.h" // to include norm
 #include "VectorWithOffset.h" // to include norm
 #include "GetBraOrKet.h"
+#include <mutex>
 
 namespace Dmrg {
 
+/* PSIDOC ObserverHelper
+When \verb!ObserveMemoryBudget=! (in megabytes) is given in the input then
+the observe code does not read all the DMRG steps at startup.
+Each step is read from the data file the first time it is needed,
+and the least recently used steps are dropped from memory when
+their total size exceeds the budget.
+Code that reads a step keeps it pinned (see StepPin) while it holds
+references into it, and pinned steps are never dropped, so the budget
+can be exceeded while many steps are in use.
+It is independent of \verb!MemoryBudget=!, which only chooses the matrix vector engines.
+Without \verb!ObserveMemoryBudget=! all steps are read at startup, as before.
+*/
 template<typename IoInputType_,
          typename MatrixType_,
          typename VectorType_,
@@ -117,15 +130,45 @@ public:
 
 	enum class SaveEnum {YES, NO};
 
+	// Keeps step ind in memory while it exists. The transform, the bases,
+	// the signs and the wavefunction of a step may only be used, and
+	// references into them kept, while the step is pinned.
+	// Pins nest, and are cheap when no budget is given
+	class StepPin {
+
+	public:
+
+		StepPin(const ObserverHelper& helper, SizeType ind)
+		    : helper_(helper), ind_(ind)
+		{
+			helper_.pin(ind_);
+		}
+
+		~StepPin() { helper_.unpin(ind_); }
+
+	private:
+
+		StepPin(const StepPin&);
+
+		StepPin& operator=(const StepPin&);
+
+		const ObserverHelper& helper_;
+		const SizeType ind_;
+	}; // class StepPin
+
 	ObserverHelper(IoInputType& io,
 	               SizeType start,
 	               SizeType nf,
 	               SizeType trail,
-	               bool withLegacyBugs)
+	               bool withLegacyBugs,
+	               SizeType memoryBudget)
 	    : io_(io),
 	      withLegacyBugs_(withLegacyBugs),
+	      memoryBudget_(memoryBudget),
 	      noMoreData_(false),
-	      numberOfSites_(0)
+	      numberOfSites_(0),
+	      clock_(0),
+	      resident_(0)
 	{
 		typename BasisWithOperatorsType::VectorBoolType odds;
 		io_.read(odds, "OddElectronsOneSite");
@@ -141,6 +184,11 @@ public:
 		if (trail > 0)
 			if (!init(start, start + trail, SaveEnum::NO))
 				return;
+
+		if (memoryBudget_ == 0) return;
+
+		std::cerr<<__FILE__<<" "<<steps_.size()<<" steps will be read on demand";
+		std::cerr<<" with ObserveMemoryBudget="<<memoryBudget_<<"\n";
 	}
 
 	~ObserverHelper()
@@ -164,20 +212,20 @@ public:
 	               const SparseMatrixType& O2,
 	               SizeType ind) const
 	{
-		checkIndex(ind);
-		return dSerializerV_[ind]->transform(ret, O2);
+		StepPin pin(*this, ind);
+		return serializer(ind).transform(ret, O2);
 	}
 
 	SizeType cols(SizeType ind) const
 	{
-		checkIndex(ind);
-		return dSerializerV_[ind]->cols();
+		StepPin pin(*this, ind);
+		return serializer(ind).cols();
 	}
 
 	SizeType rows(SizeType ind) const
 	{
-		checkIndex(ind);
-		return dSerializerV_[ind]->rows();
+		StepPin pin(*this, ind);
+		return serializer(ind).rows();
 	}
 
 	short int signsOneSite(SizeType site) const
@@ -188,33 +236,28 @@ public:
 
 	const FermionSignType& fermionicSignLeft(SizeType ind) const
 	{
-		checkIndex(ind);
-		return dSerializerV_[ind]->fermionicSignLeft();
+		return serializer(ind).fermionicSignLeft();
 	}
 
 	const FermionSignType& fermionicSignRight(SizeType ind) const
 	{
-		checkIndex(ind);
-		return dSerializerV_[ind]->fermionicSignRight();
+		return serializer(ind).fermionicSignRight();
 	}
 
 	const LeftRightSuperType& leftRightSuper(SizeType ind) const
 	{
-		checkIndex(ind);
-		return dSerializerV_[ind]->leftRightSuper();
+		return serializer(ind).leftRightSuper();
 	}
 
 	ProgramGlobals::DirectionEnum direction(SizeType ind) const
 	{
 		checkIndex(ind);
-		return dSerializerV_[ind]->direction();
+		return directions_[ind];
 	}
 
 	const VectorWithOffsetType& wavefunction(SizeType ind) const
 	{
-		checkIndex(ind);
-
-		return dSerializerV_[ind]->wavefunction();
+		return serializer(ind).wavefunction();
 	}
 
 	RealType time(SizeType ind) const
@@ -229,7 +272,7 @@ public:
 	{
 		if (timeSerializerV_.size() == 0) {
 			checkIndex(ind);
-			return dSerializerV_[ind]->site();
+			return sites_[ind];
 		}
 
 		assert(ind < timeSerializerV_.size());
@@ -237,7 +280,7 @@ public:
 		return timeSerializerV_[ind]->site();
 	}
 
-	SizeType size() const { return dSerializerV_.size(); }
+	SizeType size() const { return steps_.size(); }
 
 	const VectorWithOffsetType& getVectorFromBracketId(PsimagLite::String braOrKet,
 	                                                   SizeType index) const
@@ -291,21 +334,53 @@ private:
 		io_.read(total, prefix + "/Size");
 		if (start >= end || start >= total || end > total) return false;
 
-		for (SizeType i = start; i < end; ++i) {
-
-			DmrgSerializerType* dSerializer = new DmrgSerializerType(io_,
-			                                                         prefix + "/" + ttos(i),
-			                                                         false,
-			                                                         true);
-
+		if (numberOfSites_ == 0) {
+			try {
+				io_.read(numberOfSites_, prefix + "/NumberOfSites");
+			} catch (...) {}
+		}
 
-			SizeType tmp = dSerializer->leftRightSuper().sites();
-			if (tmp > 0 && numberOfSites_ == 0) numberOfSites_ = tmp;
+		for (SizeType i = start; i < end; ++i) {
 
-			if (saveOrNot == SaveEnum::YES)
+			// site and direction of each step are read without the rest of it,
+			// unless the data file is older than that
+			SizeType site = 0;
+			ProgramGlobals::DirectionEnum dir = ProgramGlobals::DirectionEnum::INFINITE;
+			bool indexed = false;
+			if (saveOrNot == SaveEnum::YES) {
+				try {
+					io_.read(site, prefix + "/" + ttos(i) + "/Site");
+					io_.read(dir, prefix + "/" + ttos(i) + "/direction");
+					indexed = true;
+				} catch (...) {}
+			}
+
+			// with a budget only the steps needed to find the number of sites
+			// and, for older files, the sites are read now;
+			// the rest are read on demand by serializer()
+			DmrgSerializerType* dSerializer = 0;
+			const bool needed = (saveOrNot == SaveEnum::YES && (memoryBudget_ == 0 || !indexed));
+			if (numberOfSites_ == 0 || needed) {
+				dSerializer = load(i);
+				SizeType tmp = dSerializer->leftRightSuper().sites();
+				if (tmp > 0 && numberOfSites_ == 0) numberOfSites_ = tmp;
+				site = dSerializer->site();
+				dir = dSerializer->direction();
+			}
+
+			if (saveOrNot == SaveEnum::YES) {
+				steps_.push_back(i);
+				sites_.push_back(site);
+				directions_.push_back(dir);
 				dSerializerV_.push_back(dSerializer);
-			else
+				bytes_.push_back((dSerializer) ? dSerializer->memory() : 0);
+				resident_ += bytes_.back();
+				lastUse_.push_back(0);
+				pins_.push_back(0);
+				if (memoryBudget_ > 0) evict();
+			} else {
 				delete dSerializer;
+			}
 
 			try {
 				PsimagLite::String prefix("/TargetingCommon/" + ttos(i));
@@ -320,7 +395,75 @@ private:
 		}
 
 		noMoreData_ = (end == total);
-		return (dSerializerV_.size() > 0);
+		return (steps_.size() > 0);
+	}
+
+	DmrgSerializerType* load(SizeType step) const
+	{
+		return new DmrgSerializerType(io_, "Serializer/" + ttos(step), false, true);
+	}
+
+	// step ind must be pinned if there is a budget; no lock is needed
+	// because a pinned step is neither loaded nor dropped
+	const DmrgSerializerType& serializer(SizeType ind) const
+	{
+		checkIndex(ind);
+
+		if (!dSerializerV_[ind])
+			err("dSerializerV_ at index " + ttos(ind) + " point to 0x0; is it pinned?\n");
+		return *dSerializerV_[ind];
+	}
+
+	void pin(SizeType ind) const
+	{
+		checkIndex(ind);
+
+		if (memoryBudget_ == 0) return;
+
+		std::lock_guard<std::mutex> guard(mutex_);
+
+		++pins_[ind];
+		lastUse_[ind] = ++clock_;
+		if (dSerializerV_[ind]) return;
+
+		dSerializerV_[ind] = load(steps_[ind]);
+		bytes_[ind] = dSerializerV_[ind]->memory();
+		resident_ += bytes_[ind];
+		evict();
+	}
+
+	void unpin(SizeType ind) const
+	{
+		if (memoryBudget_ == 0) return;
+
+		std::lock_guard<std::mutex> guard(mutex_);
+
+		assert(pins_[ind] > 0);
+		--pins_[ind];
+		evict();
+	}
+
+	// drops the least recently used steps that are not pinned
+	// until the budget is met; must be called with mutex_ held
+	void evict() const
+	{
+		const SizeType budget = memoryBudget_*1024*1024;
+		while (resident_ > budget) {
+			SizeType lru = 0;
+			SizeType counter = 0;
+			for (SizeType i = 0; i < dSerializerV_.size(); ++i) {
+				if (!dSerializerV_[i] || pins_[i] > 0) continue;
+				if (counter == 0 || lastUse_[i] < lastUse_[lru]) lru = i;
+				++counter;
+			}
+
+			if (counter == 0) return;
+
+			delete dSerializerV_[lru];
+			dSerializerV_[lru] = 0;
+			resident_ -= bytes_[lru];
+			bytes_[lru] = 0;
+		}
 	}
 
 	static SizeType braketStringToNumber(const PsimagLite::String& str)
@@ -336,21 +479,32 @@ private:
 
 	void checkIndex(SizeType ind) const
 	{
-		if (ind >= dSerializerV_.size())
-			err("Index " + ttos(ind) + " bigger than " + ttos(dSerializerV_.size()));
+		if (ind < steps_.size()) return;
 
-		if (dSerializerV_[ind]) return;
-
-		err("dSerializerV_ at index " + ttos(ind) + " point to 0x0\n");
+		err("Index " + ttos(ind) + " bigger than " + ttos(steps_.size()));
 	}
 
+	ObserverHelper(const ObserverHelper&);
+
+	ObserverHelper& operator=(const ObserverHelper&);
+
 	IoInputType& io_;
-	typename PsimagLite::Vector<DmrgSerializerType*>::Type dSerializerV_;
+	VectorSizeType steps_;
+	VectorSizeType sites_;
+	typename PsimagLite::Vector<ProgramGlobals::DirectionEnum>::Type directions_;
+	mutable typename PsimagLite::Vector<DmrgSerializerType*>::Type dSerializerV_;
+	mutable VectorSizeType bytes_;
+	mutable VectorSizeType lastUse_;
+	mutable VectorSizeType pins_;
 	typename PsimagLite::Vector<TimeSerializerType*>::Type timeSerializerV_;
 	const bool withLegacyBugs_;
+	const SizeType memoryBudget_;
 	bool noMoreData_;
 	VectorShortIntType signsOneSite_;
 	SizeType numberOfSites_;
+	mutable SizeType clock_;
+	mutable SizeType resident_;
+	mutable std::mutex mutex_;
 };  // ObserverHelper
 } // namespace Dmrg
 
@@ -100,7 +100,10 @@ class OnePointCorrelations {
 
 public:
 
-	OnePointCorrelations(const ObserverHelperType& helper) : helper_(helper)
+	// threads is the number of threads an application of an operator may
+	// use; give 1 when measuring inside an outer parallel loop
+	OnePointCorrelations(const ObserverHelperType& helper, SizeType threads)
+	    : helper_(helper), threads_(threads)
 	{}
 
 	template<typename ApplyOperatorType>
@@ -112,6 +115,7 @@ public:
 	{
 		const SizeType ptr = site;
 		try {
+			typename ObserverHelperType::StepPin pin(helper_, ptr);
 			const VectorWithOffsetType& src1 = helper_.getVectorFromBracketId(bra, ptr);
 			const VectorWithOffsetType& src2 = helper_.getVectorFromBracketId(ket, ptr);
 
@@ -131,6 +135,7 @@ public:
 	{
 		const SizeType ptr = site;
 		try {
+			typename ObserverHelperType::StepPin pin(helper_, ptr);
 			const VectorWithOffsetType& src1 = helper_.getVectorFromBracketId(bra, ptr);
 			const VectorWithOffsetType& src2 = helper_.getVectorFromBracketId(ket, ptr);
 
@@ -156,7 +161,8 @@ private:
 	{
 		if (src1.sectors() == 0 || src2.sectors() == 0) return 0.0;
 		ApplyOperatorType applyOpLocal1(helper_.leftRightSuper(ptr),
-		                                helper_.withLegacyBugs());
+		                                helper_.withLegacyBugs(),
+		                                threads_);
 		VectorWithOffsetType dest;
 		applyOpLocal1(dest,
 		              src1,
@@ -189,7 +195,8 @@ private:
 	{
 
 		ApplyOperatorType applyOpLocal1(helper_.leftRightSuper(ptr),
-		                                helper_.withLegacyBugs());
+		                                helper_.withLegacyBugs(),
+		                                threads_);
 		VectorWithOffsetType dest;
 		applyOpLocal1.hookForZero(dest,
 		                          src1,
@@ -215,6 +222,7 @@ private:
 	}
 
 	const ObserverHelperType& helper_;
+	SizeType threads_;
 };  //class OnePointCorrelations
 } // namespace Dmrg
 
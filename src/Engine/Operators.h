@@ -85,6 +85,8 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include "Complex.h"
 #include "Concurrency.h"
 #include "Parallelizer.h"
+#include <algorithm>
+#include <thread>
 
 namespace Dmrg {
 /* PSIDOC Operators
@@ -125,6 +127,8 @@ public:
 	typedef typename PsimagLite::Vector<RealType>::Type VectorRealType;
 	typedef typename PsimagLite::Vector<SizeType>::Type VectorSizeType;
 	typedef std::pair<SizeType,SizeType> PairSizeSizeType;
+	typedef typename PsimagLite::Vector<bool>::Type VectorBoolType;
+	typedef typename PsimagLite::Vector<OperatorType>::Type VectorOperatorType;
 
 	// law of the excluded middle went out the window here:
 	enum class ChangeAllEnum { UNSET, TRUE_SET, FALSE_SET};
@@ -213,9 +217,116 @@ public:
 		const PairSizeSizeType& startEnd_;
 	};
 
+	// Builds the operators of indices from their factors, one per task, into the
+	// product of basis2 and basis3, writing each row directly in the order of the
+	// product basis: row r is the state permutation[r] = a + b*n2 of the outer
+	// product, with a in basis2 and b in basis3.
+	// Factors of basis2 become A x I, and those of basis3 become I x B with
+	// the fermionic sign of a
+	class MyProductLoop {
+
+		typedef std::pair<SizeType, ComplexOrRealType> PairSizeValueType;
+		typedef typename PsimagLite::Vector<PairSizeValueType>::Type VectorPairSizeValueType;
+
+	public:
+
+		MyProductLoop(const Operators& ops, const VectorSizeType& indices)
+		    : ops_(ops),
+		      indices_(indices),
+		      built_(indices.size()),
+		      hasMpi_(ConcurrencyType::hasMpi())
+		{}
+
+		void doTask(SizeType taskNumber, SizeType)
+		{
+			const SizeType k = indices_[taskNumber];
+			product(built_[taskNumber].data,
+			        ops_.factors_[k],
+			        (k < ops_.leftFactors_),
+			        ops_.signs2_,
+			        ops_.permutation_,
+			        ops_.permutationInverse_);
+		}
+
+		SizeType tasks() const { return indices_.size(); }
+
+		void gather()
+		{
+			if (ConcurrencyType::isMpiDisabled("Operators")) return;
+			if (!hasMpi_) return;
+
+			PsimagLite::MPI::pointByPointGather(built_);
+			for (SizeType i = 0; i < built_.size(); i++)
+				Dmrg::bcast(built_[i]);
+		}
+
+		VectorOperatorType& built() { return built_; }
+
+		static void product(SparseMatrixType& result,
+		                    const OperatorType& m,
+		                    bool isLeft,
+		                    const VectorBoolType& signs2,
+		                    const VectorSizeType& permutation,
+		                    const VectorSizeType& permutationInverse)
+		{
+			const bool isFermion = (m.fermionOrBoson == ProgramGlobals::FermionOrBosonEnum::FERMION);
+			const SizeType n2 = signs2.size();
+			const SizeType n = permutation.size();
+			const SparseMatrixType& a = m.data;
+			const SizeType nout = n/a.rows();
+
+			SparseMatrixType c(n, n, a.nonZeros()*nout);
+			VectorPairSizeValueType row;
+			SizeType counter = 0;
+			for (SizeType r = 0; r < n; ++r) {
+				c.setRow(r, counter);
+				const SizeType p = permutation[r];
+				const SizeType alpha = p % n2;
+				const SizeType beta = p/n2;
+				row.clear();
+				if (isLeft) {
+					for (int kk = a.getRowPtr(alpha); kk < a.getRowPtr(alpha + 1); ++kk) {
+						const SizeType q = a.getCol(kk) + beta*n2;
+						row.push_back(PairSizeValueType(permutationInverse[q], a.getValue(kk)));
+					}
+				} else {
+					const RealType sign = (isFermion && signs2[alpha]) ? -1 : 1;
+					for (int kk = a.getRowPtr(beta); kk < a.getRowPtr(beta + 1); ++kk) {
+						const SizeType q = alpha + a.getCol(kk)*n2;
+						row.push_back(PairSizeValueType(permutationInverse[q],
+						                                a.getValue(kk)*sign));
+					}
+				}
+
+				std::sort(row.begin(), row.end(), lessColumn);
+				for (SizeType x = 0; x < row.size(); ++x) {
+					c.setCol(counter, row[x].first);
+					c.setValues(counter++, row[x].second);
+				}
+			}
+
+			c.setRow(n, counter);
+			c.checkValidity();
+			result.swap(c);
+		}
+
+	private:
+
+		static bool lessColumn(const PairSizeValueType& p1, const PairSizeValueType& p2)
+		{
+			return (p1.first < p2.first);
+		}
+
+		const Operators& ops_;
+		const VectorSizeType& indices_;
+		VectorOperatorType built_;
+		bool hasMpi_;
+	};
+
 	Operators(const BasisType* thisBasis)
 	    : reducedOpImpl_(thisBasis),
-	      progress_("Operators")
+	      progress_("Operators"),
+	      leftFactors_(0)
 	{
 		if (changeAll_ == ChangeAllEnum::UNSET)
 			changeAll_ = ChangeAllEnum::FALSE_SET;
@@ -228,7 +339,8 @@ public:
 	          const BasisType* thisBasis,
 	          bool isObserveCode)
 	    : reducedOpImpl_(io,level,thisBasis),
-	      progress_("Operators")
+	      progress_("Operators"),
+	      leftFactors_(0)
 	{
 		if (changeAll_ == ChangeAllEnum::UNSET)
 			changeAll_ = ChangeAllEnum::FALSE_SET;
@@ -248,6 +360,7 @@ public:
 		prefix += "/";
 
 		if (!BasisType::useSu2Symmetry()) {
+			clearPending();
 			io.read(operators_, prefix + "Operators");
 		} else {
 			if (roi) reducedOpImpl_.read(io);
@@ -278,6 +391,7 @@ public:
 
 	void setOperators(const typename PsimagLite::Vector<OperatorType>::Type& ops)
 	{
+		clearPending();
 		if (!BasisType::useSu2Symmetry()) operators_=ops;
 		else reducedOpImpl_.setOperators(ops);
 	}
@@ -292,6 +406,10 @@ public:
 	{
 		assert(!BasisType::useSu2Symmetry());
 		assert(i>=0 && SizeType(i)<operators_.size());
+		// an operator still kept as a factor must not be built in a threaded region
+		assert(SizeType(i) >= pending_.size() || !pending_[i] ||
+		       std::this_thread::get_id() == serialThread_);
+		materialize(i);
 		return operators_[i];
 	}
 
@@ -307,10 +425,30 @@ public:
 		return operators_.size();
 	}
 
+	// Builds, in parallel, those operators of indices still kept as factors;
+	// call it from serial code, before several threads may ask for them
+	void build(const VectorSizeType& indices) const
+	{
+		if (pending_.size() == 0) return;
+
+		VectorSizeType toBuild;
+		for (SizeType i = 0; i < indices.size(); ++i) {
+			const SizeType k = indices[i];
+			assert(k < pending_.size());
+			if (!pending_[k]) continue;
+			if (std::find(toBuild.begin(), toBuild.end(), k) != toBuild.end()) continue;
+			toBuild.push_back(k);
+		}
+
+		buildPending(toBuild);
+	}
+
 	void changeBasis(const BlockDiagonalMatrixType& ftransform,
 	                 const BasisType* thisBasis,
 	                 const PairSizeSizeType& startEnd)
 	{
+		materialize(startEnd);
+
 		typedef PsimagLite::Parallelizer<MyLoop> ParallelizerType;
 		ParallelizerType threadObject(PsimagLite::Concurrency::codeSectionParams);
 
@@ -323,13 +461,62 @@ public:
 		reducedOpImpl_.changeBasisHamiltonian(hamiltonian_,ftransform);
 	}
 
+	// Copies other, but only the data of the operators in [startEnd.first, startEnd.second);
+	// the others are left empty, as changeBasis would leave them
+	void copyOperators(const Operators& other, const PairSizeSizeType& startEnd)
+	{
+		reducedOpImpl_ = other.reducedOpImpl_;
+		hamiltonian_ = other.hamiltonian_;
+		// operators not yet built are copied as factors, and built by changeBasis
+		pending_ = other.pending_;
+		factors_ = other.factors_;
+		leftFactors_ = other.leftFactors_;
+		signs2_ = other.signs2_;
+		permutation_ = other.permutation_;
+		permutationInverse_ = other.permutationInverse_;
+		serialThread_ = std::this_thread::get_id();
+
+		if (BasisType::useSu2Symmetry() || changeAll_ == ChangeAllEnum::TRUE_SET) {
+			operators_ = other.operators_;
+			return;
+		}
+
+		const SizeType n = other.operators_.size();
+		operators_.resize(n);
+		for (SizeType k = 0; k < n; ++k) {
+			const OperatorType& op = other.operators_[k];
+			if (k >= startEnd.first && k < startEnd.second) {
+				operators_[k] = op;
+				continue;
+			}
+
+			if (k < pending_.size()) {
+				pending_[k] = false;
+				factors_[k].data.clear();
+			}
+
+			operators_[k] = OperatorType(SparseMatrixType(),
+			                             op.fermionOrBoson,
+			                             op.jm,
+			                             op.angularFactor,
+			                             op.su2Related);
+		}
+	}
+
 	void reorder(const VectorSizeType& permutation)
 	{
+		materialize(PairSizeSizeType(0, operators_.size()));
 		for (SizeType k=0;k<numberOfOperators();k++) {
 			if (!BasisType::useSu2Symmetry())
 				reorder(operators_[k].data,permutation);
 			reducedOpImpl_.reorder(k,permutation);
 		}
+
+		reorderHamiltonian(permutation);
+	}
+
+	void reorderHamiltonian(const VectorSizeType& permutation)
+	{
 		reorder(hamiltonian_,permutation);
 		reducedOpImpl_.reorderHamiltonian(permutation);
 	}
@@ -344,6 +531,7 @@ public:
 	                  SizeType x,
 	                  const BasisType* thisBasis)
 	{
+		clearPending();
 		if (!BasisType::useSu2Symmetry())
 			operators_.resize(x);
 		reducedOpImpl_.setToProduct(basis2,basis3,x,thisBasis);
@@ -390,6 +578,43 @@ public:
 		apply(operators_[i].data);
 	}
 
+	// Sets all operators to the product of those of ops2 and ops3, in the
+	// order of permutation. Only their factors are kept here; each operator
+	// is built by MyProductLoop the first time it is needed, see materialize
+	void externalProduct(const Operators& ops2,
+	                     const Operators& ops3,
+	                     const VectorBoolType& signs2,
+	                     const VectorSizeType& permutation,
+	                     const VectorSizeType& permutationInverse)
+	{
+		assert(!BasisType::useSu2Symmetry());
+		const SizeType n2ops = ops2.operators_.size();
+		const SizeType n = n2ops + ops3.operators_.size();
+		operators_.resize(n);
+		factors_.resize(n);
+		pending_.resize(n);
+		for (SizeType k = 0; k < n; ++k) {
+			factors_[k] = (k < n2ops) ? ops2.getOperatorByIndex(k)
+			                          : ops3.getOperatorByIndex(k - n2ops);
+			const OperatorType& m = factors_[k];
+			// don't forget to set fermion sign and j:
+			operators_[k] = OperatorType(SparseMatrixType(),
+			                             m.fermionOrBoson,
+			                             m.jm,
+			                             m.angularFactor,
+			                             m.su2Related);
+			// operators not transformed at the last truncation stay empty
+			pending_[k] = (m.data.rows() > 0);
+			if (!pending_[k]) factors_[k].data.clear();
+		}
+
+		leftFactors_ = n2ops;
+		signs2_ = signs2;
+		permutation_ = permutation;
+		permutationInverse_ = permutationInverse;
+		serialThread_ = std::this_thread::get_id();
+	}
+
 	void externalProductReduced(SizeType i,
 	                            const BasisType& basis2,
 	                            const BasisType& basis3,
@@ -442,6 +667,7 @@ public:
 	void print(int ind= -1) const
 	{
 		if (!BasisType::useSu2Symmetry()) {
+			materialize(PairSizeSizeType(0, operators_.size()));
 			if (ind<0)
 				for (SizeType i=0;i<operators_.size();i++) std::cerr<<operators_[i];
 			else std::cerr<<operators_[ind];
@@ -456,6 +682,7 @@ public:
 	               typename PsimagLite::EnableIf<
 	               PsimagLite::IsOutputLike<SomeIoOutType>::True, int*>::Type = 0) const
 	{
+		materialize(PairSizeSizeType(0, operators_.size()));
 		if (!BasisType::useSu2Symmetry())
 			io.overwrite(operators_, s + "/Operators");
 		else
@@ -468,6 +695,7 @@ public:
 	           const PsimagLite::String& s,
 	           PsimagLite::IoNgSerializer::WriteMode mode) const
 	{
+		materialize(PairSizeSizeType(0, operators_.size()));
 		if (!BasisType::useSu2Symmetry()) {
 			if (mode == PsimagLite::IoNgSerializer::ALLOW_OVERWRITE)
 				io.overwrite(operators_, s + "/Operators");
@@ -490,10 +718,91 @@ public:
 		reducedOpImpl_.clear();
 		operators_.clear();
 		hamiltonian_.clear();
+		clearPending();
 	}
 
 private:
 
+	// builds operator k if it is still a factor, without a lock: the
+	// Hamiltonian connection builds the operators of its links with build()
+	// before its products run in threads, so only serial code gets here
+	// for an operator not yet built, as getOperatorByIndex asserts.
+	// (The commit that introduced the factors, 04c5d1f, says they are built
+	// under a lock; that is out of date, there is no lock.)
+	void materialize(SizeType k) const
+	{
+		if (pending_.size() == 0 || !pending_[k]) return;
+
+		MyProductLoop::product(operators_[k].data,
+		                       factors_[k],
+		                       (k < leftFactors_),
+		                       signs2_,
+		                       permutation_,
+		                       permutationInverse_);
+		factors_[k].data.clear();
+		pending_[k] = false;
+	}
+
+	// builds, in parallel, the operators in [startEnd.first, startEnd.second)
+	// still kept as factors, or all of them if changeAll_ is set; the factors of the
+	// others are dropped
+	void materialize(const PairSizeSizeType& startEnd) const
+	{
+		if (pending_.size() == 0) return;
+
+		VectorSizeType indices;
+		for (SizeType k = 0; k < pending_.size(); ++k) {
+			if (!pending_[k]) continue;
+			const bool inRange = (k >= startEnd.first && k < startEnd.second);
+			if (inRange || changeAll_ == ChangeAllEnum::TRUE_SET) {
+				indices.push_back(k);
+				continue;
+			}
+
+			factors_[k].data.clear();
+			pending_[k] = false;
+		}
+
+		buildPending(indices);
+	}
+
+	// indices must be pending and distinct
+	void buildPending(const VectorSizeType& indices) const
+	{
+		if (indices.size() > 0) {
+			typedef PsimagLite::Parallelizer<MyProductLoop> ParallelizerType;
+			ParallelizerType threadObject(PsimagLite::Concurrency::codeSectionParams);
+
+			MyProductLoop helper(*this, indices);
+
+			threadObject.loopCreate(helper);
+
+			helper.gather();
+
+			VectorOperatorType& built = helper.built();
+			for (SizeType i = 0; i < indices.size(); ++i) {
+				const SizeType k = indices[i];
+				operators_[k].data.swap(built[i].data);
+				factors_[k].data.clear();
+				pending_[k] = false;
+			}
+		}
+
+		for (SizeType k = 0; k < pending_.size(); ++k)
+			if (pending_[k]) return;
+
+		clearPending();
+	}
+
+	void clearPending() const
+	{
+		pending_.clear();
+		factors_.clear();
+		signs2_.clear();
+		permutation_.clear();
+		permutationInverse_.clear();
+	}
+
 	void reorder(SparseMatrixType &v,const   VectorSizeType& permutation)
 	{
 		if (v.rows() == 0 || v.cols() == 0) {
@@ -535,9 +844,19 @@ private:
 
 	static ChangeAllEnum changeAll_;
 	ReducedOperatorsType reducedOpImpl_;
-	typename PsimagLite::Vector<OperatorType>::Type operators_;
+	mutable typename PsimagLite::Vector<OperatorType>::Type operators_;
 	SparseMatrixType hamiltonian_;
 	PsimagLite::ProgressIndicator progress_;
+	// operators set by externalProduct but not built yet have pending_ true,
+	// and their factor in factors_; see materialize
+	mutable VectorBoolType pending_;
+	mutable VectorOperatorType factors_;
+	SizeType leftFactors_;
+	mutable VectorBoolType signs2_;
+	mutable VectorSizeType permutation_;
+	mutable VectorSizeType permutationInverse_;
+	// thread that set the factors; only it may build them
+	std::thread::id serialThread_;
 }; //class Operators
 
 template<typename T>
@@ -1,9 +1,33 @@
 #ifndef ORACLECHEBYSHEV_H
 #define ORACLECHEBYSHEV_H
 #include "ScaledHamiltonian.h"
+#include <fstream>
 
 namespace Dmrg {
 
+/* PSIDOC OracleChebyshev
+With \verb!KpmMoments=! in the input, and TSPAlgorithm=Chebyshev,
+each time the sweep is at the first site of TSPSites
+DMRG++ computes the spectral function
+$A(\omega)=\sum_n|\langle n|A^\dagger|gs\rangle|^2\delta(\omega-E_n+E_0)$
+of the first TSPOperator $A$ with the kernel polynomial method, and writes it
+to a file named like OutputFile= but ending in Kpm.txt, overwriting the
+previous one, so that at the end the file holds the last pass over that site.
+The Hamiltonian, scaled with ChebyshevTransform so that its spectrum is inside
+$(-1, 1)$, is built once per step, and the moments $2n$ and $2n+1$ are obtained
+from $\langle\phi_n|\phi_n\rangle$ and $\langle\phi_{n+1}|\phi_n\rangle$, so that
+KpmMoments moments need only about half as many matrix vector products.
+\begin{itemize}
+\item[KpmMoments] [Integer] Number of moments; zero, the default, disables this.
+\item[KpmKernel] [String] Either \verb!Jackson!, the default, or \verb!Lorentz!.
+\item[KpmLambda] [RealType] $\lambda$ of the Lorentz kernel, 4 by default.
+\item[KpmOmegaBegin] [RealType] First frequency, measured from the ground state energy.
+\item[KpmOmegaStep] [RealType] Step of the frequencies.
+\item[KpmOmegaTotal] [Integer] Number of frequencies.
+\end{itemize}
+Each line of the file has $\omega$ and $A(\omega)$, and frequencies
+outside the scaled spectrum have zero.
+*/
 template<typename TargetingCommonType, typename TargetParamsType>
 class OracleChebyshev {
 
@@ -21,22 +45,74 @@ public:
 	typedef typename LanczosSolverType::MatrixType MatrixLanczosType;
 	typedef ScaledHamiltonian<MatrixLanczosType, TargetParamsType> ScaledHamiltonianType;
 	typedef typename PsimagLite::Vector<ComplexOrRealType>::Type VectorType;
+	typedef typename PsimagLite::Vector<RealType>::Type VectorRealType;
 	typedef typename TargetingCommonType::FermionSignType FermionSignType;
+	typedef typename TargetingCommonType::BorderEnumType BorderEnumType;
+	typedef typename ModelType::InputValidatorType InputValidatorType;
+	typedef typename TargetingCommonType::ApplyOperatorExpressionType::LanczosMatrixCacheType
+	LanczosMatrixCacheType;
+
+	enum class KernelEnum {JACKSON, LORENTZ};
 
 	OracleChebyshev(const ModelType& model,
 	                const LeftRightSuperType& lrs,
 	                const RealType& currentTime,
 	                const TargetParamsType& tstStruct,
-	                RealType E0)
-	    : model_(model), lrs_(lrs), currentTime_(currentTime), tstStruct_(tstStruct), E0_(E0)
-	{}
+	                const RealType& E0,
+	                InputValidatorType& io)
+	    : model_(model),
+	      lrs_(lrs),
+	      currentTime_(currentTime),
+	      tstStruct_(tstStruct),
+	      E0_(E0),
+	      progress_("OracleChebyshev"),
+	      moments_(0),
+	      kernel_(KernelEnum::JACKSON),
+	      lambda_(4.0),
+	      omegaBegin_(0.0),
+	      omegaStep_(0.0),
+	      omegaTotal_(0)
+	{
+		try {
+			io.readline(moments_, "KpmMoments=");
+		} catch (std::exception&) {}
+
+		if (moments_ == 0) return;
+
+		if (moments_ < 2)
+			err("KpmMoments= must be at least 2\n");
+
+		PsimagLite::String kernel("Jackson");
+		try {
+			io.readline(kernel, "KpmKernel=");
+		} catch (std::exception&) {}
+
+		if (kernel == "Lorentz")
+			kernel_ = KernelEnum::LORENTZ;
+		else if (kernel != "Jackson")
+			err("KpmKernel= must be Jackson or Lorentz, not " + kernel + "\n");
+
+		try {
+			io.readline(lambda_, "KpmLambda=");
+		} catch (std::exception&) {}
+
+		io.readline(omegaBegin_, "KpmOmegaBegin=");
+		io.readline(omegaStep_, "KpmOmegaStep=");
+		io.readline(omegaTotal_, "KpmOmegaTotal=");
+
+		PsimagLite::String filename = model.params().filename;
+		size_t lastindex = filename.find_last_of(".");
+		filename_ = filename.substr(0, lastindex) + "Kpm.txt";
+	}
 
-	void operator()(SizeType n,
-	                const TargetingCommonType& common,
-	                SizeType systemOrEnviron,
+	bool enabled() const { return (moments_ > 0); }
+
+	// spectral function of A at site; writes it to the file
+	void operator()(const TargetingCommonType& common,
+	                ProgramGlobals::DirectionEnum systemOrEnviron,
 	                SizeType site,
-	                OperatorType& A,
-	                typename TargetingCommonType::BorderEnumType border)
+	                const OperatorType& A,
+	                BorderEnumType border) const
 	{
 		VectorWithOffsetType p0;
 		typename TargetingCommonType::ApplyOperatorType applyOpLocal(lrs_,
@@ -46,65 +122,130 @@ public:
 		FermionSignType fs(lrs_.left(), signs);
 		OperatorType Aprime = A;
 		Aprime.dagger();
-		applyOpLocal(p0,common.psi(),Aprime,fs,systemOrEnviron,border);
-
-		VectorWithOffsetType p1;
-		VectorType r;
-		chebyIteration(r, p0, p0, true);
-		p1.fromFull(r, lrs_.super());
-		for (SizeType i = 0; i < n; ++i) {
-			chebyIteration(r, p1, p0, false); // p2 = 2*H*p1 - p0;
-			VectorWithOffsetType p2;
-			p2.fromFull(r, lrs_.super());
-			// <gs|c|p2>;
-			ComplexOrRealType result = common.testRealWork(p2,
-			                                               common.psi(),
-			                                               systemOrEnviron,
-			                                               site,
-			                                               A,
-			                                               border);
-			std::cout<<"OracleChebyshev: <gs|H|p"<<(i+2)<<">= "<<result<<"\n";
-			// prepare for next iteration
-			p0 = p1;
-			p1 = p2;
-		}
+		applyOpLocal(p0,common.aoe().psi(),Aprime,fs,systemOrEnviron,border);
+
+		VectorRealType mu(moments_, 0.0);
+		for (SizeType ii = 0; ii < p0.sectors(); ++ii)
+			addMoments(mu, p0, p0.sector(ii), common.aoe().lanczosMatrices());
+
+		dampen(mu);
+		write(mu, site);
 	}
 
 private:
 
-	void chebyIteration(VectorType& r,
-	                    const VectorWithOffsetType& p1,
-	                    const VectorWithOffsetType& p0,
-	                    bool firstOne) const
+	// adds the moments of sector i0 of p0; the Hamiltonian of the sector is built once
+	void addMoments(VectorRealType& mu,
+	                const VectorWithOffsetType& p0,
+	                SizeType i0,
+	                const LanczosMatrixCacheType& lanczosMatrices) const
+	{
+		SizeType p = lrs_.super().findPartitionNumber(p0.offset(i0));
+		const typename LanczosMatrixCacheType::BuiltPtrType built = lanczosMatrices(p, currentTime_);
+		const MatrixLanczosType& lanczosHelper = built->matrix();
+
+		ScaledHamiltonianType lanczosHelper2(lanczosHelper,
+		                                     tstStruct_,
+		                                     E0_,
+		                                     ProgramGlobals::VerboseEnum::NO);
+
+		const SizeType total = p0.effectiveSize(i0);
+		VectorType phiPrev(total);
+		p0.extract(phiPrev, i0);
+		VectorType phi(total, 0.0);
+		lanczosHelper2.matrixVectorProduct(phi, phiPrev); // applying Hprime
+		VectorType phiNext(total);
+
+		// T_0 and T_1
+		const RealType mu0 = PsimagLite::real(dot(phiPrev, phiPrev));
+		const RealType mu1 = PsimagLite::real(dot(phiPrev, phi));
+		mu[0] += mu0;
+		mu[1] += mu1;
+
+		for (SizeType n = 1; 2*n < moments_; ++n) {
+			mu[2*n] += 2.0*PsimagLite::real(dot(phi, phi)) - mu0;
+			if (2*n + 1 == moments_) break;
+
+			// phiNext = 2*H'*phi - phiPrev
+			std::fill(phiNext.begin(), phiNext.end(), 0.0);
+			lanczosHelper2.matrixVectorProduct(phiNext, phi);
+			for (SizeType i = 0; i < total; ++i)
+				phiNext[i] = 2.0*phiNext[i] - phiPrev[i];
+
+			mu[2*n + 1] += 2.0*PsimagLite::real(dot(phiNext, phi)) - mu1;
+			phiPrev.swap(phi);
+			phi.swap(phiNext);
+		}
+	}
+
+	void dampen(VectorRealType& mu) const
+	{
+		const RealType n = moments_;
+		const RealType pi = M_PI;
+		for (SizeType i = 0; i < moments_; ++i) {
+			RealType g = 1.0;
+			if (kernel_ == KernelEnum::JACKSON) {
+				const RealType q = pi/(n + 1.0);
+				g = (n - i + 1.0)*cos(q*i) + sin(q*i)*cos(q)/sin(q);
+				g /= (n + 1.0);
+			} else {
+				g = sinh(lambda_*(1.0 - i/n))/sinh(lambda_);
+			}
+
+			mu[i] *= g;
+		}
+	}
+
+	void write(const VectorRealType& mu, SizeType site) const
+	{
+		const RealType c = tstStruct_.chebyTransform()[0];
+		const RealType d = tstStruct_.chebyTransform()[1];
+		const RealType pi = M_PI;
+
+		std::ofstream fout(filename_.c_str());
+		if (!fout || !fout.good())
+			err("OracleChebyshev: cannot open " + filename_ + "\n");
+
+		fout.precision(std::cout.precision());
+		fout<<"#site="<<site<<" E0="<<E0_<<" moments="<<moments_<<"\n";
+		for (SizeType k = 0; k < omegaTotal_; ++k) {
+			const RealType omega = omegaBegin_ + k*omegaStep_;
+			const RealType x = c*(E0_ + omega) + d;
+			RealType value = 0.0;
+			if (fabs(x) < 1.0) {
+				// sum of g_n mu_n T_n(x)
+				RealType tPrev = 1.0;
+				RealType t = x;
+				value = mu[0] + 2.0*mu[1]*t;
+				for (SizeType n = 2; n < moments_; ++n) {
+					const RealType tNext = 2.0*x*t - tPrev;
+					value += 2.0*mu[n]*tNext;
+					tPrev = t;
+					t = tNext;
+				}
+
+				value *= fabs(c)/(pi*sqrt(1.0 - x*x));
+			}
+
+			fout<<omega<<" "<<value<<"\n";
+		}
+
+		fout.close();
+
+		PsimagLite::OstringStream msg;
+		msg<<"Spectral function at site "<<site<<" with "<<moments_;
+		msg<<" moments written to "<<filename_;
+		progress_.printline(msg, std::cout);
+	}
+
+	static ComplexOrRealType dot(const VectorType& v1, const VectorType& v2)
 	{
-		SizeType i0 = 0;
-		for (SizeType ii = 0; ii < p1.sectors(); ++ii)
-			i0 = p1.sector(ii);
-
-		SizeType p = lrs_.super().findPartitionNumber(p1.offset(i0));
-		typename ModelType::HamiltonianConnectionType hc(p,
-		                                                 lrs_,
-		                                                 model_.geometry(),
-		                                                 ModelType::modelLinks(),
-		                                                 currentTime_,
-		                                                 0);
-		MatrixLanczosType lanczosHelper(model_,
-		                                hc);
-
-		ScaledHamiltonianType lanczosHelper2(lanczosHelper, tstStruct_, E0_);
-
-		SizeType total = p1.effectiveSize(i0);
-		r.resize(total);
-		VectorType x2(total);
-		const RealType factor = (firstOne) ? 1.0 : 2.0;
-		VectorWithOffsetType x = factor*p1;
-		x.extract(x2, i0);
-		lanczosHelper2.matrixVectorProduct(r, x2); // applying Hprime
-		if (firstOne) return;
-
-		VectorType phi2(total);
-		p0.extract(phi2, i0);
- 		r += (-1.0)*phi2;
+		ComplexOrRealType sum = 0.0;
+		const SizeType n = v1.size();
+		for (SizeType i = 0; i < n; ++i)
+			sum += PsimagLite::conj(v1[i])*v2[i];
+
+		return sum;
 	}
 
 	const ModelType& model_;
@@ -112,6 +253,14 @@ private:
 	const RealType& currentTime_;
 	const TargetParamsType& tstStruct_;
 	const RealType& E0_;
+	PsimagLite::ProgressIndicator progress_;
+	SizeType moments_;
+	KernelEnum kernel_;
+	RealType lambda_;
+	RealType omegaBegin_;
+	RealType omegaStep_;
+	SizeType omegaTotal_;
+	PsimagLite::String filename_;
 };
 }
 #endif // ORACLECHEBYSHEV_H
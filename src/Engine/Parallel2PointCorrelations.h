@@ -96,6 +96,33 @@ public:
 	typedef std::pair<SizeType,SizeType> PairType;
 	typedef typename PsimagLite::Real<FieldType>::Type RealType;
 
+	// one correlation: its matrix, its operators, and its bra and ket
+	struct Item {
+
+		Item(MatrixType& w_,
+		     const SparseMatrixType& O1_,
+		     const SparseMatrixType& O2_,
+		     ProgramGlobals::FermionOrBosonEnum fermionicSign_,
+		     PsimagLite::String bra_,
+		     PsimagLite::String ket_)
+		    : w(&w_),
+		      O1(&O1_),
+		      O2(&O2_),
+		      fermionicSign(fermionicSign_),
+		      bra(bra_),
+		      ket(ket_)
+		{}
+
+		MatrixType* w;
+		const SparseMatrixType* O1;
+		const SparseMatrixType* O2;
+		ProgramGlobals::FermionOrBosonEnum fermionicSign;
+		PsimagLite::String bra;
+		PsimagLite::String ket;
+	};
+
+	typedef typename PsimagLite::Vector<Item>::Type VectorItemType;
+
 	Parallel2PointCorrelations(MatrixType& w,
 	                           const TwoPointCorrelationsType& twopoint,
 	                           const typename PsimagLite::Vector<PairType>::Type& pairs,
@@ -103,42 +130,50 @@ public:
 	                           const SparseMatrixType& O2,
 	                           ProgramGlobals::FermionOrBosonEnum fermionicSign,
 	                           PsimagLite::String bra,
-	                           PsimagLite::String ket)
-	    : w_(w),
-	      twopoint_(twopoint),
+	                           PsimagLite::String ket,
+	                           SizeType offset = 0)
+	    : twopoint_(twopoint),
+	      pairs_(pairs),
+	      items_(1, Item(w, O1, O2, fermionicSign, bra, ket)),
+	      offset_(offset)
+	{}
+
+	// all items are computed for a pair before the next pair,
+	// so that the steps a pair needs are used by all of them in turn
+	Parallel2PointCorrelations(const TwoPointCorrelationsType& twopoint,
+	                           const typename PsimagLite::Vector<PairType>::Type& pairs,
+	                           const VectorItemType& items,
+	                           SizeType offset = 0)
+	    : twopoint_(twopoint),
 	      pairs_(pairs),
-	      O1_(O1),
-	      O2_(O2),
-	      fermionicSign_(fermionicSign),
-	      bra_(bra),
-	      ket_(ket)
+	      items_(items),
+	      offset_(offset)
 	{}
 
 	void doTask(SizeType taskNumber, SizeType)
 	{
 		SizeType i = pairs_[taskNumber].first;
 		SizeType j = pairs_[taskNumber].second;
-		w_(i,j) = twopoint_.calcCorrelation(i,
-		                                    j,
-		                                    O1_,
-		                                    O2_,
-		                                    fermionicSign_,
-		                                    bra_,
-		                                    ket_);
+		for (SizeType x = 0; x < items_.size(); ++x) {
+			const Item& item = items_[x];
+			(*item.w)(i - offset_, j) = twopoint_.calcCorrelation(i,
+			                                                      j,
+			                                                      *item.O1,
+			                                                      *item.O2,
+			                                                      item.fermionicSign,
+			                                                      item.bra,
+			                                                      item.ket);
+		}
 	}
 
 	SizeType tasks() const { return pairs_.size(); }
 
 private:
 
-	MatrixType& w_;
 	const TwoPointCorrelationsType& twopoint_;
 	const typename PsimagLite::Vector<PairType>::Type& pairs_;
-	const SparseMatrixType& O1_;
-	const SparseMatrixType& O2_;
-	const ProgramGlobals::FermionOrBosonEnum fermionicSign_;
-	const PsimagLite::String bra_;
-	const PsimagLite::String ket_;
+	VectorItemType items_;
+	const SizeType offset_; // row of each matrix is i - offset_
 }; // class Parallel2PointCorrelations
 } // namespace Dmrg 
 
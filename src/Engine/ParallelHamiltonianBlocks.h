@@ -0,0 +1,190 @@
+#ifndef PARALLELHAMILTONIANBLOCKS_H
+#define PARALLELHAMILTONIANBLOCKS_H
+#include "Concurrency.h"
+#include "Vector.h"
+
+namespace Dmrg {
+
+// Adds the connection Hamiltonian to a matrix one partition (symmetry sector)
+// per task, in two loops over the partitions.
+// Each task starts from the rows of the original matrix in its partition and
+// merges every link into them as soon as the link is built, dropping the link.
+// The first loop only counts the non-zeros of each partition;
+// startFill() then allocates the result once, and the second loop writes the
+// rows of each partition directly into it.
+template<typename HamiltonianConnectionType, typename ModelLinksType>
+class ParallelHamiltonianBlocks {
+
+	typedef typename HamiltonianConnectionType::ModelHelperType ModelHelperType;
+	typedef typename ModelHelperType::SparseMatrixType SparseMatrixType;
+	typedef typename ModelHelperType::LeftRightSuperType LeftRightSuperType;
+	typedef typename ModelHelperType::RealType RealType;
+	typedef typename HamiltonianConnectionType::GeometryType GeometryType;
+	typedef typename HamiltonianConnectionType::LinkType LinkType;
+	typedef typename PsimagLite::Vector<SparseMatrixType>::Type VectorSparseMatrixType;
+	typedef typename PsimagLite::Vector<SizeType>::Type VectorSizeType;
+	typedef PsimagLite::Vector<int>::Type VectorIntType;
+	typedef PsimagLite::Concurrency ConcurrencyType;
+
+public:
+
+	ParallelHamiltonianBlocks(const SparseMatrixType& matrix,
+	                          const LeftRightSuperType& lrs,
+	                          const GeometryType& geometry,
+	                          const ModelLinksType& modelLinks,
+	                          RealType currentTime,
+	                          SizeType threads)
+	    : matrix_(matrix),
+	      lrs_(lrs),
+	      geometry_(geometry),
+	      modelLinks_(modelLinks),
+	      currentTime_(currentTime),
+	      nonZeros_(lrs.super().partition() - 1, 0),
+	      result_(0),
+	      blocks_(ConcurrencyType::storageSize(threads)),
+	      scratch_(ConcurrencyType::storageSize(threads)),
+	      columnToPosition_(ConcurrencyType::storageSize(threads))
+	{}
+
+	void doTask(SizeType m, SizeType threadNum)
+	{
+		SparseMatrixType& block = blocks_[threadNum];
+		buildBlock(block, m, threadNum);
+
+		if (!result_) {
+			nonZeros_[m] = block.nonZeros();
+			return;
+		}
+
+		// nonZeros_[m] is now the position of the first non-zero of partition m
+		assert(static_cast<SizeType>(block.nonZeros()) == nonZeros_[m + 1] - nonZeros_[m]);
+		const SizeType offset = lrs_.super().partition(m);
+		SizeType counter = nonZeros_[m];
+		for (SizeType i = 0; i < block.rows(); ++i) {
+			result_->setRow(i + offset, counter);
+			for (int k = block.getRowPtr(i); k < block.getRowPtr(i + 1); ++k) {
+				result_->setCol(counter, block.getCol(k));
+				result_->setValues(counter++, block.getValue(k));
+			}
+		}
+	}
+
+	SizeType tasks() const { return lrs_.super().partition() - 1; }
+
+	// call after the counting loop and before the filling loop
+	void startFill(SparseMatrixType& result)
+	{
+		SizeType total = 0;
+		for (SizeType m = 0; m < nonZeros_.size(); ++m) {
+			const SizeType tmp = nonZeros_[m];
+			nonZeros_[m] = total;
+			total += tmp;
+		}
+
+		nonZeros_.push_back(total);
+		const SizeType n = matrix_.rows();
+		SparseMatrixType matrix(n, n, total);
+		matrix.setRow(n, total);
+		result.swap(matrix);
+		result_ = &result;
+	}
+
+private:
+
+	// rows of partition m, with columns of the full matrix
+	void buildBlock(SparseMatrixType& block, SizeType m, SizeType threadNum)
+	{
+		const SizeType offset = lrs_.super().partition(m);
+		const SizeType bs = lrs_.super().partition(m + 1) - offset;
+
+		VectorIntType& columnToPosition = columnToPosition_[threadNum];
+		if (columnToPosition.size() != matrix_.cols())
+			columnToPosition.resize(matrix_.cols(), -1);
+
+		block.resize(bs, matrix_.cols());
+		SizeType counter = 0;
+		for (SizeType i = 0; i < bs; ++i) {
+			block.setRow(i, counter);
+			const SizeType row = i + offset;
+			for (int k = matrix_.getRowPtr(row); k < matrix_.getRowPtr(row + 1); ++k) {
+				block.pushCol(matrix_.getCol(k));
+				block.pushValue(matrix_.getValue(k));
+				++counter;
+			}
+		}
+
+		block.setRow(bs, counter);
+
+		HamiltonianConnectionType hc(m, lrs_, geometry_, modelLinks_, currentTime_, 0);
+		const SizeType total = hc.tasks();
+		SparseMatrixType link;
+		SparseMatrixType& merged = scratch_[threadNum];
+		for (SizeType x = 0; x < total; ++x) {
+			SparseMatrixType const* A = 0;
+			SparseMatrixType const* B = 0;
+			const LinkType& link2 = hc.getKron(&A, &B, x);
+			hc.modelHelper().fastOpProdInter(*A, *B, link, link2);
+			merge(merged, block, link, offset, columnToPosition);
+			block.swap(merged);
+		}
+
+		merged.clear();
+		block.checkValidity();
+	}
+
+	// merged = block + link, where the columns of link are those of partition
+	// starting at offset
+	static void merge(SparseMatrixType& merged,
+	                  const SparseMatrixType& block,
+	                  const SparseMatrixType& link,
+	                  SizeType offset,
+	                  VectorIntType& columnToPosition)
+	{
+		const SizeType bs = block.rows();
+		merged.resize(bs, block.cols());
+		SizeType counter = 0;
+		for (SizeType i = 0; i < bs; ++i) {
+			merged.setRow(i, counter);
+			for (int k = block.getRowPtr(i); k < block.getRowPtr(i + 1); ++k)
+				add(merged, counter, block.getCol(k), block.getValue(k), columnToPosition);
+
+			for (int k = link.getRowPtr(i); k < link.getRowPtr(i + 1); ++k)
+				add(merged, counter, link.getCol(k) + offset, link.getValue(k), columnToPosition);
+
+			for (SizeType k = merged.getRowPtr(i); k < counter; ++k)
+				columnToPosition[merged.getCol(k)] = -1;
+		}
+
+		merged.setRow(bs, counter);
+	}
+
+	static void add(SparseMatrixType& block,
+	                SizeType& counter,
+	                SizeType col,
+	                const typename SparseMatrixType::value_type& value,
+	                VectorIntType& columnToPosition)
+	{
+		const int pos = columnToPosition[col];
+		if (pos >= 0) {
+			block.setValues(pos, block.getValue(pos) + value);
+			return;
+		}
+
+		columnToPosition[col] = counter++;
+		block.pushCol(col);
+		block.pushValue(value);
+	}
+
+	const SparseMatrixType& matrix_;
+	const LeftRightSuperType& lrs_;
+	const GeometryType& geometry_;
+	const ModelLinksType& modelLinks_;
+	RealType currentTime_;
+	VectorSizeType nonZeros_;
+	SparseMatrixType* result_;
+	VectorSparseMatrixType blocks_;
+	VectorSparseMatrixType scratch_;
+	typename PsimagLite::Vector<VectorIntType>::Type columnToPosition_;
+}; // class ParallelHamiltonianBlocks
+} // namespace Dmrg
+#endif // PARALLELHAMILTONIANBLOCKS_H
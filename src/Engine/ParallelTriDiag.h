@@ -79,6 +79,7 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 
 #include "Mpi.h"
 #include "Concurrency.h"
+#include "LanczosMatrixCache.h"
 
 namespace Dmrg {
 
@@ -100,6 +101,8 @@ public:
 	typedef typename PsimagLite::Vector<ComplexOrRealType>::Type TargetVectorType;
 	typedef PsimagLite::Matrix<ComplexOrRealType> MatrixComplexOrRealType;
 	typedef typename PsimagLite::Vector<MatrixComplexOrRealType>::Type VectorMatrixFieldType;
+	typedef LanczosMatrixCache<ModelType, typename LanczosSolverType::MatrixType>
+	LanczosMatrixCacheType;
 
 	ParallelTriDiag(const VectorWithOffsetType& phi,
 	                VectorMatrixFieldType& T,
@@ -107,7 +110,7 @@ public:
 	                typename PsimagLite::Vector<SizeType>::Type& steps,
 	                const LeftRightSuperType& lrs,
 	                RealType currentTime,
-	                const ModelType& model,
+	                const LanczosMatrixCacheType& lanczosMatrices,
 	                InputValidatorType& io)
 	    : phi_(phi),
 	      T_(T),
@@ -115,7 +118,7 @@ public:
 	      steps_(steps),
 	      lrs_(lrs),
 	      currentTime_(currentTime),
-	      model_(model),
+	      lanczosMatrices_(lanczosMatrices),
 	      io_(io)
 	{}
 
@@ -135,13 +138,9 @@ private:
 	                 SizeType i0)
 	{
 		SizeType p = lrs_.super().findPartitionNumber(phi.offset(i0));
-		typename ModelType::HamiltonianConnectionType hc(p,
-		                                                 lrs_,
-		                                                 model_.geometry(),
-		                                                 ModelType::modelLinks(),
-		                                                 currentTime_,
-		                                                 0);
-		typename LanczosSolverType::MatrixType lanczosHelper(model_, hc);
+		const typename LanczosMatrixCacheType::BuiltPtrType built =
+		        lanczosMatrices_(p, currentTime_);
+		const typename LanczosSolverType::MatrixType& lanczosHelper = built->matrix();
 
 		typename LanczosSolverType::ParametersSolverType params(io_,"Tridiag");
 		params.lotaMemory = true;
@@ -166,7 +165,7 @@ private:
 	typename PsimagLite::Vector<SizeType>::Type& steps_;
 	const LeftRightSuperType& lrs_;
 	RealType currentTime_;
-	const ModelType& model_;
+	const LanczosMatrixCacheType& lanczosMatrices_;
 	InputValidatorType& io_;
 }; // class ParallelTriDiag
 } // namespace Dmrg
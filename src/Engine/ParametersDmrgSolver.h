@@ -152,6 +152,8 @@ struct ParametersDmrgSolver {
 	SizeType dumperEnd;
 	SizeType precision;
 	SizeType recoveryMaxFiles;
+	SizeType memoryBudget;
+	SizeType observeMemoryBudget;
 	int useReflectionSymmetry;
 	bool autoRestart;
 	PairRealSizeType truncationControl;
@@ -160,6 +162,7 @@ struct ParametersDmrgSolver {
 	PsimagLite::String options;
 	PsimagLite::String model;
 	PsimagLite::String insitu;
+	PsimagLite::String insituTwoPoint;
 	PsimagLite::String fileForDensityMatrixEigs;
 	PsimagLite::String recoverySave;
 	RestartStruct checkpoint;
@@ -190,9 +193,12 @@ struct ParametersDmrgSolver {
 		ioSerializer.write(root + "/options", options);
 		ioSerializer.write(root + "/model", model);
 		ioSerializer.write(root + "/insitu", insitu);
+		ioSerializer.write(root + "/insituTwoPoint", insituTwoPoint);
 		ioSerializer.write(root + "/fileForDensityMatrixEigs", fileForDensityMatrixEigs);
 		ioSerializer.write(root + "/recoverySave", recoverySave);
 		ioSerializer.write(root + "/recoveryMaxFiles", recoveryMaxFiles);
+		ioSerializer.write(root + "/memoryBudget", memoryBudget);
+		ioSerializer.write(root + "/observeMemoryBudget", observeMemoryBudget);
 		checkpoint.write(label + "/checkpoint", ioSerializer);
 		ioSerializer.write(root + "/adjustQuantumNumbers", adjustQuantumNumbers);
 		ioSerializer.write(root + "/finiteLoop", finiteLoop);
@@ -221,6 +227,8 @@ struct ParametersDmrgSolver {
 	      dumperEnd(0),
 	      precision(6),
 	      recoveryMaxFiles(3),
+	      memoryBudget(0),
+	      observeMemoryBudget(0),
 	      autoRestart(false),
 	      recoverySave("no"),
 	      adjustQuantumNumbers(0, QnType(false, VectorSizeType(), PairSizeType(0, 0), 0)),
@@ -306,6 +314,11 @@ struct ParametersDmrgSolver {
 			io.readline(insitu,"insitu=");
 		} catch (std::exception&) {}
 
+		insituTwoPoint = "";
+		try {
+			io.readline(insituTwoPoint,"InSituTwoPoint=");
+		} catch (std::exception&) {}
+
 		try {
 			io.readline(sitesPerBlock,"SitesPerBlock=");
 		} catch (std::exception&) {}
@@ -314,6 +327,14 @@ struct ParametersDmrgSolver {
 			io.readline(maxMatrixRankStored,"MaxMatrixRankStored=");
 		} catch (std::exception&) {}
 
+		try {
+			io.readline(memoryBudget,"MemoryBudget=");
+		} catch (std::exception&) {}
+
+		try {
+			io.readline(observeMemoryBudget,"ObserveMemoryBudget=");
+		} catch (std::exception&) {}
+
 		try {
 			io.readline(excited,"Excited=");
 		} catch (std::exception&) {}
@@ -606,6 +627,15 @@ struct ParametersDmrgSolver {
 		if (p.options.find("MatrixVectorStored")==PsimagLite::String::npos)
 			os<<"MaxMatrixRankStored="<<p.maxMatrixRankStored<<"\n";
 
+		if (p.memoryBudget > 0)
+			os<<"MemoryBudget="<<p.memoryBudget<<"\n";
+
+		if (p.observeMemoryBudget > 0)
+			os<<"ObserveMemoryBudget="<<p.observeMemoryBudget<<"\n";
+
+		if (p.insituTwoPoint != "")
+			os<<"InSituTwoPoint="<<p.insituTwoPoint<<"\n";
+
 		return os;
 	}
 
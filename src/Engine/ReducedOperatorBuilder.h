@@ -0,0 +1,101 @@
+#ifndef REDUCEDOPERATORBUILDER_H
+#define REDUCEDOPERATORBUILDER_H
+#include "Vector.h"
+#include <algorithm>
+
+namespace Dmrg {
+
+// Builds the reduced (Wigner-Eckart) form of operators for Su2Reduced and
+// ReducedOperators.
+// opDest is built row by row, never as a dense n times n matrix;
+// a row of opDest collects all rows of the sources with the same reduced
+// index, divided by the Clebsch-Gordan coefficient of each entry.
+// The recoupling factors themselves are still the m-sums of Su2Reduced and
+// ReducedOperators; no closed-form 6j/9j coefficients are used.
+template<typename OperatorType, typename BasisType, typename ClebschGordanType>
+class ReducedOperatorBuilder {
+
+	typedef typename OperatorType::StorageType SparseMatrixType;
+	typedef typename SparseMatrixType::value_type SparseElementType;
+	typedef typename PsimagLite::Real<SparseElementType>::Type RealType;
+	typedef typename OperatorType::PairType PairType;
+	typedef typename PsimagLite::Vector<SparseElementType>::Type VectorType;
+	typedef typename PsimagLite::Vector<SizeType>::Type VectorSizeType;
+	typedef typename PsimagLite::Vector<bool>::Type VectorBoolType;
+
+public:
+
+	typedef typename PsimagLite::Vector<const OperatorType*>::Type VectorPointerOperatorType;
+
+	// basisrInverse maps each state of basis to its reduced index, below n
+	static void create(SparseMatrixType& opDest,
+	                   const VectorPointerOperatorType& opSrc,
+	                   const BasisType& basis,
+	                   const VectorSizeType& basisrInverse,
+	                   SizeType n,
+	                   ClebschGordanType& cgObject)
+	{
+		typename PsimagLite::Vector<VectorSizeType>::Type rowsOfReduced(n);
+		for (SizeType i=0;i<basisrInverse.size();i++)
+			rowsOfReduced[basisrInverse[i]].push_back(i);
+
+		VectorType value(n,0.0);
+		VectorBoolType seen(n,false);
+		VectorSizeType cols;
+		opDest.resize(n,n);
+		SizeType counter = 0;
+		for (SizeType r=0;r<n;r++) {
+			opDest.setRow(r,counter);
+			cols.clear();
+			for (SizeType x=0;x<opSrc.size();x++)
+				for (SizeType y=0;y<rowsOfReduced[r].size();y++)
+					addReducedRow(value,seen,cols,*opSrc[x],basis,basisrInverse,
+					              rowsOfReduced[r][y],cgObject);
+
+			std::sort(cols.begin(),cols.end());
+			for (SizeType c=0;c<cols.size();c++) {
+				const SizeType col = cols[c];
+				const SparseElementType val = value[col];
+				value[col] = 0.0;
+				seen[col] = false;
+				// contributions may cancel to an exact zero, which is not stored
+				if (val == static_cast<SparseElementType>(0.0)) continue;
+				opDest.pushCol(col);
+				opDest.pushValue(val);
+				counter++;
+			}
+		}
+
+		opDest.setRow(n,counter);
+		opDest.checkValidity();
+	}
+
+private:
+
+	// adds row i of opSrc to the row of opDest being built
+	static void addReducedRow(VectorType& value,
+	                          VectorBoolType& seen,
+	                          VectorSizeType& cols,
+	                          const OperatorType& opSrc,
+	                          const BasisType& basis,
+	                          const VectorSizeType& basisrInverse,
+	                          SizeType i,
+	                          ClebschGordanType& cgObject)
+	{
+		if (i>=opSrc.data.rows()) return;
+
+		PairType jm = basis.jmValue(i);
+		for (int l=opSrc.data.getRowPtr(i);l<opSrc.data.getRowPtr(i+1);l++) {
+			SizeType iprime = opSrc.data.getCol(l);
+			PairType jmPrime = basis.jmValue(iprime);
+			RealType divisor = opSrc.angularFactor*(jmPrime.first+1);
+			const SizeType col = basisrInverse[iprime];
+			value[col] += opSrc.data.getValue(l)*cgObject(jmPrime,jm,opSrc.jm)/divisor;
+			if (seen[col]) continue;
+			seen[col] = true;
+			cols.push_back(col);
+		}
+	}
+}; // class ReducedOperatorBuilder
+} // namespace Dmrg
+#endif // REDUCEDOPERATORBUILDER_H
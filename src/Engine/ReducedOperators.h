@@ -84,6 +84,7 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include "ChangeOfBasis.h"
 #include "BlockOffDiagMatrix.h"
 #include "../KronUtil/MatrixDenseOrSparse.h"
+#include "ReducedOperatorBuilder.h"
 
 namespace Dmrg {
 template<typename BasisType>
@@ -99,7 +100,10 @@ class ReducedOperators {
 	typedef PsimagLite::Matrix<SparseElementType> DenseMatrixType;
 	typedef Su2SymmetryGlobals<RealType> Su2SymmetryGlobalsType;
 	typedef typename PsimagLite::Vector<OperatorType_>::Type VectorOperatorType;
-	typedef typename PsimagLite::Vector<const OperatorType_*>::Type
+	typedef ReducedOperatorBuilder<OperatorType_,
+	BasisType,
+	ClebschGordanType> ReducedOperatorBuilderType;
+	typedef typename ReducedOperatorBuilderType::VectorPointerOperatorType
 	VectorPointerOperatorType;
 	typedef typename PsimagLite::Vector<SparseElementType>::Type VectorType;
 	typedef typename PsimagLite::Vector<VectorType>::Type VectorVectorType;
@@ -563,28 +567,12 @@ private:
 	void createReducedOperator(SparseMatrixType& opDest,
 	                           const VectorPointerOperatorType& opSrc)
 	{
-		SizeType n = thisBasis_->reducedSize();
-		DenseMatrixType opDest1(n,n);
-		for (SizeType i=0;i<opSrc.size();i++)
-			createReducedOperator(opDest1,*opSrc[i]);
-		fullMatrixToCrsMatrix(opDest,opDest1);
-	}
-
-	void createReducedOperator(DenseMatrixType& opDest1,const OperatorType& opSrc)
-	{
-		DenseMatrixType opSrcDense;
-		crsMatrixToFullMatrix(opSrcDense, opSrc.data);
-		for (SizeType i=0;i<opSrc.data.rows();i++) {
-			PairType jm = thisBasis_->jmValue(i);
-			for (int l=opSrc.data.getRowPtr(i);l<opSrc.data.getRowPtr(i+1);l++) {
-				SizeType iprime = opSrc.data.getCol(l);
-				PairType jmPrime = thisBasis_->jmValue(iprime);
-				RealType divisor = opSrc.angularFactor*(jmPrime.first+1);
-				opDest1(basisrinverse_[i],basisrinverse_[iprime]) +=
-				        opSrcDense(i,iprime)*
-				        cgObject_->operator()(jmPrime,jm,opSrc.jm)/divisor;
-			}
-		}
+		ReducedOperatorBuilderType::create(opDest,
+		                                   opSrc,
+		                                   *thisBasis_,
+		                                   basisrinverse_,
+		                                   thisBasis_->reducedSize(),
+		                                   *cgObject_);
 	}
 
 	void buildLfactor(VectorType& lfactor,
@@ -0,0 +1,97 @@
+#ifndef SECTORCHUNKS_H
+#define SECTORCHUNKS_H
+#include "Concurrency.h"
+#include "Parallelizer.h"
+#include "Vector.h"
+#include <algorithm>
+
+namespace Dmrg {
+
+// Splits ranges of states of the superblock, one range per sector, in chunks
+// for a loop that may run in threads; used by the brackets of
+// CorrelationsSkeleton and by ApplyOperatorLocal.
+// threads is the number of threads the caller may use, and it is given
+// explicitly: callers that already run inside a parallel loop give 1.
+// A range is split in about as many chunks as threads, but no chunk
+// has fewer than MIN_STATES states, so that starting threads pays off.
+class SectorChunks {
+
+public:
+
+	static const SizeType MIN_STATES = 256;
+
+	// states start to end (not included) of sector
+	struct Chunk {
+
+		Chunk(SizeType sector_, SizeType start_, SizeType end_)
+		    : sector(sector_), start(start_), end(end_)
+		{}
+
+		SizeType sector;
+		SizeType start;
+		SizeType end;
+	};
+
+	explicit SectorChunks(SizeType threads)
+	    : threads_(std::max(threads, static_cast<SizeType>(1)))
+	{}
+
+	void push(SizeType sector, SizeType start, SizeType end)
+	{
+		SizeType states = (end - start + threads_ - 1)/threads_;
+		if (states < MIN_STATES) states = MIN_STATES;
+		for (SizeType s = start; s < end; s += states)
+			chunks_.push_back(Chunk(sector, s, std::min(s + states, end)));
+	}
+
+	void clear() { chunks_.clear(); }
+
+	SizeType size() const { return chunks_.size(); }
+
+	const Chunk& operator[](SizeType i) const
+	{
+		assert(i < chunks_.size());
+		return chunks_[i];
+	}
+
+	// true if a loop over the chunks is worth running in threads
+	bool inThreads() const { return (threads_ > 1 && chunks_.size() > 1); }
+
+	// helper.doTask(i, threadNum) for every chunk i, with the given parallelizer
+	// if inThreads(), or serially otherwise
+	template<typename HelperType, typename ParallelizerType>
+	void loop(HelperType& helper, ParallelizerType& parallelizer) const
+	{
+		assert(helper.tasks() == chunks_.size());
+		if (!inThreads()) {
+			for (SizeType i = 0; i < chunks_.size(); ++i)
+				helper.doTask(i, 0);
+			return;
+		}
+
+		parallelizer.loopCreate(helper);
+	}
+
+	// as above, with a parallelizer of up to threads threads made for this loop
+	template<typename HelperType>
+	void loop(HelperType& helper) const
+	{
+		typedef PsimagLite::Parallelizer<HelperType> ParallelizerType;
+		if (!inThreads()) {
+			for (SizeType i = 0; i < chunks_.size(); ++i)
+				helper.doTask(i, 0);
+			return;
+		}
+
+		PsimagLite::CodeSectionParams codeSectionParams(std::min(threads_, chunks_.size()));
+		ParallelizerType parallelizer(codeSectionParams);
+		loop(helper, parallelizer);
+	}
+
+private:
+
+	SizeType threads_;
+	PsimagLite::Vector<Chunk>::Type chunks_;
+}; // class SectorChunks
+} // namespace Dmrg
+#endif // SECTORCHUNKS_H
@@ -75,6 +75,7 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include "Map.h"
 #include "Su2SymmetryGlobals.h"
 #include "Sort.h"
+#include "ReducedOperatorBuilder.h"
 
 /** \ingroup DMRG */
 /*@{*/
@@ -99,6 +100,9 @@ class Su2Reduced {
 	typedef typename OperatorsType::OperatorType OperatorType;
 	typedef Su2SymmetryGlobals<RealType> Su2SymmetryGlobalsType;
 	typedef typename Su2SymmetryGlobalsType::ClebschGordanType ClebschGordanType;
+	typedef ReducedOperatorBuilder<OperatorType,
+	BasisWithOperatorsType,
+	ClebschGordanType> ReducedOperatorBuilderType;
 
 	static const SizeType System=0,Environ=1;
 
@@ -201,7 +205,7 @@ private:
 		}
 
 		SizeType angularMomentum =0;
-		typename PsimagLite::Vector<const OperatorType*>::Type opSrc(angularMomentum+1);
+		typename ReducedOperatorBuilderType::VectorPointerOperatorType opSrc(angularMomentum+1);
 
 		OperatorType myOp;
 		myOp.data = basis.hamiltonian();
@@ -209,7 +213,12 @@ private:
 		myOp.jm=typename OperatorType::PairType(0,0);
 		myOp.angularFactor = 1.0;
 		opSrc[0]=&myOp;
-		createReducedOperator(hamReduced,opSrc,basis,basisrinverse,basis.reducedSize(),0);
+		ReducedOperatorBuilderType::create(hamReduced,
+		                                   opSrc,
+		                                   basis,
+		                                   basisrinverse,
+		                                   basis.reducedSize(),
+		                                   cgObject_);
 	}
 
 	SizeType findJf(const BasisWithOperatorsType& basis,SizeType j,SizeType f)
@@ -249,40 +258,6 @@ private:
 		}
 	}
 
-	void createReducedOperator(SparseMatrixType& opDest,
-	                           const typename PsimagLite::Vector<const OperatorType*>::Type& opSrc,
-	                           const BasisWithOperatorsType& basis,
-	                           const typename PsimagLite::Vector<SizeType>::Type& basisrInverse,
-	                           SizeType n,
-	                           SizeType)
-	{
-		PsimagLite::Matrix<SparseElementType> opDest1(n,n);
-		for (SizeType i=0;i<opSrc.size();i++)
-			createReducedOperator(opDest1,*opSrc[i],basis,basisrInverse);
-		fullMatrixToCrsMatrix(opDest,opDest1);
-	}
-
-	void createReducedOperator(PsimagLite::Matrix<SparseElementType>& opDest1,
-	                           const OperatorType& opSrc,
-	                           const BasisWithOperatorsType& basis,
-	                           const typename PsimagLite::Vector<SizeType>::Type& basisrInverse)
-	{
-		PsimagLite::Matrix<SparseElementType> opSrcdense;
-		crsMatrixToFullMatrix(opSrcdense, opSrc.data);
-		for (SizeType i=0;i<opSrc.data.rows();i++) {
-			PairType jm = basis.jmValue(i);
-			for (int l=opSrc.data.getRowPtr(i);l<opSrc.data.getRowPtr(i+1);l++) {
-				SizeType iprime = opSrc.data.getCol(l);
-				PairType jmPrime = basis.jmValue(iprime);
-
-				RealType divisor = opSrc.angularFactor*(jmPrime.first+1);
-				opDest1(basisrInverse[i],basisrInverse[iprime]) +=
-				        opSrcdense(i,iprime)*cgObject_(jmPrime,jm,opSrc.jm)/divisor;
-
-			}
-		}
-	}
-
 	void buildAdditional(PsimagLite::Matrix<SparseElementType>& lfactor,
 	                     SizeType k,
 	                     SizeType mu1,
@@ -380,6 +355,9 @@ private:
 		reorderMap();
 	}
 
+	// Sum over m of four Clebsch-Gordan coefficients, not memoized.
+	// A closed form with 6j/9j coefficients would need a sum over the coupled
+	// rank as well, since mu1 and mu2 are fixed here; it is not done.
 	SparseElementType calcLfactor(SizeType j1,
 	                              SizeType j2,
 	                              SizeType j1prime,
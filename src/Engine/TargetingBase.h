@@ -122,6 +122,7 @@ public:
 	typedef typename PsimagLite::Vector<OperatorType>::Type VectorOperatorType;
 	typedef typename ApplyOperatorExpressionType::StageEnumType StageEnumType;
 	typedef typename ApplyOperatorExpressionType::DmrgSerializerType DmrgSerializerType;
+	typedef typename ApplyOperatorExpressionType::LanczosMatrixCacheType LanczosMatrixCacheType;
 
 	TargetingBase(const LeftRightSuperType& lrs,
 	              const ModelType& model,
@@ -257,6 +258,17 @@ public:
 		commonTargeting_.aoe().multiSitePush(ds);
 	}
 
+	// Lanczos matrices kept for the targeting of a step, invalid once lrs changes
+	void clearLanczosMatrices()
+	{
+		commonTargeting_.aoe().clearLanczosMatrices();
+	}
+
+	const LanczosMatrixCacheType& lanczosMatrices() const
+	{
+		return commonTargeting_.aoe().lanczosMatrices();
+	}
+
 protected:
 
 	TargetingCommonType& common()
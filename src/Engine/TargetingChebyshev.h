@@ -93,6 +93,7 @@ public:
 	typedef LanczosSolverType_ LanczosSolverType;
 	typedef TargetingBase<LanczosSolverType,VectorWithOffsetType_> BaseType;
 	typedef typename BaseType::TargetingCommonType TargetingCommonType;
+	typedef typename BaseType::LanczosMatrixCacheType LanczosMatrixCacheType;
 	typedef std::pair<SizeType,SizeType> PairType;
 	typedef typename BaseType::MatrixVectorType MatrixVectorType;
 	typedef typename MatrixVectorType::ModelType ModelType;
@@ -118,6 +119,7 @@ public:
 	typedef typename TargetingCommonType::ApplyOperatorExpressionType ApplyOperatorExpressionType;
 	typedef typename ApplyOperatorExpressionType::ApplyOperatorType ApplyOperatorType;
 	typedef typename TargetingCommonType::StageEnumType StageEnumType;
+	typedef OracleChebyshev<TargetingCommonType, TargetParamsType> OracleChebyshevType;
 
 	TargetingChebyshev(const LeftRightSuperType& lrs,
 	                   const ModelType& model,
@@ -131,7 +133,13 @@ public:
 	      times_(tstStruct_.timeSteps()),
 	      weight_(tstStruct_.timeSteps()),
 	      tvEnergy_(times_.size(),0.0),
-	      gsWeight_(tstStruct_.gsWeight())
+	      gsWeight_(tstStruct_.gsWeight()),
+	      oracle_(model,
+	              lrs,
+	              this->common().aoe().currentTime(),
+	              tstStruct_,
+	              this->common().aoe().energy(),
+	              ioIn)
 	{
 		if (!wft.isEnabled())
 			err("TST needs an enabled wft\n");
@@ -202,6 +210,7 @@ public:
 	            SizeType loopNumber)
 	{
 		evolveInternal(Eg, direction, block1, loopNumber);
+		oracleChebyshev(direction, block1);
 		bool doBorderIfBorder = true;
 		this->common().cocoon(block1, direction, doBorderIfBorder); // in-situ
 	}
@@ -279,17 +288,22 @@ private:
 		assert(phiNew.offset(0) == this->common().aoe().targetVectors()[1].offset(0));
 	}
 
-	void oracleChebyshev(SizeType site, SizeType systemOrEviron) const
+	// spectral function with KPM, if enabled, at the first site of TSPSites
+	void oracleChebyshev(ProgramGlobals::DirectionEnum direction,
+	                     const BlockType& block1) const
 	{
-		typedef OracleChebyshev<TargetingCommonType, TargetParamsType> OracleChebyshevType;
-		OracleChebyshevType oracle(BaseType::model(),
-		                           BaseType::lrs(),
-		                           this->common().aoe().currentTime(),
-		                           tstStruct_,
-		                           this->common().aoe().energy());
-
-		OperatorType A = BaseType::model().naturalOperator("c", 0, 0);
-		oracle(3, this->common(), systemOrEviron, site, A, ApplyOperatorType::BORDER_NO);
+		if (!oracle_.enabled()) return;
+		if (direction == ProgramGlobals::DirectionEnum::INFINITE) return;
+
+		assert(block1.size() > 0);
+		if (block1[0] != tstStruct_.sites(0)) return;
+
+		assert(tstStruct_.aOperators().size() > 0);
+		oracle_(this->common(),
+		        direction,
+		        block1[0],
+		        tstStruct_.aOperators()[0],
+		        ApplyOperatorType::BORDER_NO);
 	}
 
 	void printChebyshev() const
@@ -311,14 +325,9 @@ private:
 	                    SizeType i0) const
 	{
 		SizeType p = this->lrs().super().findPartitionNumber(phi.offset(i0));
-		typename ModelType::HamiltonianConnectionType hc(p,
-		                                                 BaseType::lrs(),
-		                                                 BaseType::model().geometry(),
-		                                                 BaseType::model().modelLinks(),
-		                                                 this->common().aoe().currentTime(),
-		                                                 0);
-		typename LanczosSolverType::MatrixType lanczosHelper(BaseType::model(),
-		                                                     hc);
+		const typename LanczosMatrixCacheType::BuiltPtrType built =
+		        this->lanczosMatrices()(p, this->common().aoe().currentTime());
+		const typename LanczosSolverType::MatrixType& lanczosHelper = built->matrix();
 
 		SizeType total = phi.effectiveSize(i0);
 		TargetVectorType phi2(total);
@@ -344,6 +353,7 @@ private:
 	VectorRealType weight_;
 	mutable VectorRealType tvEnergy_;
 	RealType gsWeight_;
+	OracleChebyshevType oracle_;
 };     //class TargetingChebyshev
 } // namespace Dmrg
 
@@ -155,7 +155,12 @@ public:
 	      progress_("TargetingCorrectionVector"),
 	      gsWeight_(1.0),
 	      correctionEnabled_(false),
-	      skeleton_(ioIn_, tstStruct_, model, lrs, this->common().aoe().energy())
+	      skeleton_(ioIn_,
+	                tstStruct_,
+	                model,
+	                lrs,
+	                this->common().aoe().lanczosMatrices(),
+	                this->common().aoe().energy())
 	{
 		if (!wft.isEnabled())
 			err("TargetingCorrectionVector needs wft\n");
@@ -104,6 +104,7 @@ public:
 	typedef LanczosSolverType_ LanczosSolverType;
 	typedef TargetingBase<LanczosSolverType,VectorWithOffsetType_> BaseType;
 	typedef typename BaseType::TargetingCommonType TargetingCommonType;
+	typedef typename BaseType::LanczosMatrixCacheType LanczosMatrixCacheType;
 	typedef typename BaseType::MatrixVectorType MatrixVectorType;
 	typedef typename MatrixVectorType::ModelType ModelType;
 	typedef typename ModelType::RealType RealType;
@@ -281,13 +282,9 @@ private:
 	                       SizeType p)
 	{
 		RealType fakeTime = 0;
-		typename ModelType::HamiltonianConnectionType hc(p,
-		                                                 BaseType::lrs(),
-		                                                 BaseType::model().geometry(),
-		                                                 ModelType::modelLinks(),
-		                                                 fakeTime,
-		                                                 0);
-		typename LanczosSolverType::MatrixType h(BaseType::model(), hc);
+		const typename LanczosMatrixCacheType::BuiltPtrType built =
+		        this->lanczosMatrices()(p, fakeTime);
+		const typename LanczosSolverType::MatrixType& h = built->matrix();
 		paramsForSolver_.lotaMemory = true;
 		LanczosSolverType lanczosSolver(h,paramsForSolver_);
 
@@ -111,6 +111,7 @@ public:
 	typedef LanczosSolverType_ LanczosSolverType;
 	typedef TargetingBase<LanczosSolverType,VectorWithOffsetType_> BaseType;
 	typedef typename BaseType::TargetingCommonType TargetingCommonType;
+	typedef typename BaseType::LanczosMatrixCacheType LanczosMatrixCacheType;
 	typedef typename BaseType::MatrixVectorType MatrixVectorType;
 	typedef typename MatrixVectorType::ModelType ModelType;
 	typedef typename ModelType::RealType RealType;
@@ -791,14 +792,9 @@ private:
 	                   SizeType i0) const
 	{
 		SizeType p = this->lrs().super().findPartitionNumber(phi.offset(i0));
-		typename ModelType::HamiltonianConnectionType hc(p,
-		                                                 BaseType::lrs(),
-		                                                 BaseType::model().geometry(),
-		                                                 BaseType::ModelType::modelLinks(),
-		                                                 this->common().aoe().currentTime(),
-		                                                 0);
-		typename LanczosSolverType::MatrixType lanczosHelper(BaseType::model(),
-		                                                     hc);
+		const typename LanczosMatrixCacheType::BuiltPtrType built =
+		        this->lanczosMatrices()(p, this->common().aoe().currentTime());
+		const typename LanczosSolverType::MatrixType& lanczosHelper = built->matrix();
 
 		SizeType total = phi.effectiveSize(i0);
 		TargetVectorType phi2(total);
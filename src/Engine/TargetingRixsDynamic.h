@@ -164,7 +164,12 @@ public:
 	      progress_("TargetingRixsDynamic"),
 	      gsWeight_(1.0),
 	      paramsForSolver_(ioIn,"DynamicDmrg"),
-	      skeleton_(ioIn_,tstStruct_,model,lrs,this->common().aoe().energy()),
+	      skeleton_(ioIn_,
+	                tstStruct_,
+	                model,
+	                lrs,
+	                this->common().aoe().lanczosMatrices(),
+	                this->common().aoe().energy()),
 	      applied_(false),
 	      appliedFirst_(false),
 	      usesCheby_(tstStruct_.algorithm() == TargetParamsType::BaseType::AlgorithmEnum::CHEBYSHEV)
@@ -157,7 +157,12 @@ public:
 	      ioIn_(ioIn),
 	      progress_("TargetingRixsStatic"),
 	      gsWeight_(1.0),
-	      skeleton_(ioIn_,tstStruct_,model,lrs,this->common().aoe().energy()),
+	      skeleton_(ioIn_,
+	                tstStruct_,
+	                model,
+	                lrs,
+	                this->common().aoe().lanczosMatrices(),
+	                this->common().aoe().energy()),
 	      applied_(false),
 	      appliedFirst_(false)
 	{
@@ -0,0 +1,141 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+#include "Vector.h"
+#include "ProgressIndicator.h"
+#include "ProgramGlobals.h"
+#include "Concurrency.h"
+#include <fstream>
+#include <sys/resource.h>
+
+namespace Dmrg {
+
+/* PSIDOC Telemetry
+With \verb!telemetry! in SolverOptions DMRG++ writes one line of JSON
+per DMRG step to a file named like the OutputFile= but
+ending in Telemetry.jsonl. Each line has the loop, the site and direction,
+the requested and actual numbers of states, the size of the superblock and of
+each symmetry sector that was diagonalized, the steps of the eigensolver
+(Lanczos steps, or matrix vector products with useBlockDavidson), the
+floating point operations of those products as estimated for the
+matrix vector engine in use (see MatrixVectorEngineSelector), the
+energy and the truncation error, the wall time in seconds for each stage
+(grow, diagonalization, of which wft, truncation, and io), and the
+peak resident memory of the process in kilobytes.
+With MPI, only the root rank opens and writes the file.
+*/
+template<typename RealType>
+class Telemetry {
+
+	typedef PsimagLite::Vector<SizeType>::Type VectorSizeType;
+	typedef PsimagLite::MemoryUsage::TimeHandle TimeHandle;
+
+public:
+
+	enum StageEnum {STAGE_GROW, STAGE_DIAG, STAGE_TRUNCATION, STAGE_IO, STAGES};
+
+	Telemetry(PsimagLite::String filename, bool enabled)
+	    : enabled_(enabled),
+	      mark_(0, 0),
+	      wft_(0, 0),
+	      stages_(STAGES, TimeHandle(0, 0))
+	{
+		if (!enabled_ || !PsimagLite::Concurrency::root()) return;
+
+		size_t lastindex = filename.find_last_of(".");
+		PsimagLite::String file = filename.substr(0, lastindex) + "Telemetry.jsonl";
+		fout_.open(file.c_str());
+		if (!fout_ || !fout_.good())
+			err("Telemetry: cannot open " + file + "\n");
+
+		fout_.precision(12);
+	}
+
+	bool enabled() const { return enabled_; }
+
+	// starts timing a step; the time until the next mark() is not counted
+	void start()
+	{
+		if (!enabled_) return;
+
+		for (SizeType i = 0; i < stages_.size(); ++i)
+			stages_[i] = TimeHandle(0, 0);
+
+		wft_ = TimeHandle(0, 0);
+		mark_ = PsimagLite::ProgressIndicator::time();
+	}
+
+	// adds the time since the last mark to stage
+	void mark(StageEnum stage)
+	{
+		if (!enabled_) return;
+
+		const TimeHandle now = PsimagLite::ProgressIndicator::time();
+		stages_[stage] += (now - mark_);
+		mark_ = now;
+	}
+
+	void wft(const TimeHandle& time)
+	{
+		if (!enabled_) return;
+		wft_ = time;
+	}
+
+	void write(SizeType loopIndex,
+	           SizeType site,
+	           ProgramGlobals::DirectionEnum direction,
+	           SizeType keptStates,
+	           SizeType left,
+	           SizeType right,
+	           SizeType super,
+	           const VectorSizeType& sectors,
+	           SizeType solverSteps,
+	           RealType flops,
+	           RealType energy,
+	           RealType truncationError)
+	{
+		if (!enabled_ || !PsimagLite::Concurrency::root()) return;
+
+		fout_<<"{\"loop\":"<<loopIndex;
+		fout_<<",\"site\":"<<site;
+		fout_<<",\"direction\":\""<<ProgramGlobals::toString(direction)<<"\"";
+		fout_<<",\"m\":"<<keptStates;
+		fout_<<",\"left\":"<<left;
+		fout_<<",\"right\":"<<right;
+		fout_<<",\"super\":"<<super;
+		fout_<<",\"sectors\":[";
+		for (SizeType i = 0; i < sectors.size(); ++i) {
+			if (i > 0) fout_<<",";
+			fout_<<sectors[i];
+		}
+
+		fout_<<"],\"solverSteps\":"<<solverSteps;
+		fout_<<",\"flops\":"<<flops;
+		fout_<<",\"energy\":"<<energy;
+		fout_<<",\"truncationError\":"<<truncationError;
+		fout_<<",\"seconds\":{\"grow\":"<<stages_[STAGE_GROW].seconds();
+		fout_<<",\"diagonalization\":"<<stages_[STAGE_DIAG].seconds();
+		fout_<<",\"wft\":"<<wft_.seconds();
+		fout_<<",\"truncation\":"<<stages_[STAGE_TRUNCATION].seconds();
+		fout_<<",\"io\":"<<stages_[STAGE_IO].seconds();
+		fout_<<"},\"peakRssKb\":"<<peakRss()<<"}\n";
+		fout_.flush();
+	}
+
+private:
+
+	// in kilobytes on Linux
+	static long peakRss()
+	{
+		struct rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+		return usage.ru_maxrss;
+	}
+
+	bool enabled_;
+	std::ofstream fout_;
+	TimeHandle mark_;
+	TimeHandle wft_;
+	typename PsimagLite::Vector<TimeHandle>::Type stages_;
+}; // class Telemetry
+} // namespace Dmrg
+#endif // TELEMETRY_H
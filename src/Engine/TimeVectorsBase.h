@@ -82,6 +82,7 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include <iostream>
 #include "Vector.h"
 #include "ProgramGlobals.h"
+#include "LanczosMatrixCache.h"
 
 namespace Dmrg {
 
@@ -97,6 +98,8 @@ class TimeVectorsBase  {
 public:
 
 	typedef std::pair<SizeType,SizeType> PairType;
+	typedef LanczosMatrixCache<ModelType, typename LanczosSolverType::MatrixType>
+	LanczosMatrixCacheType;
 
 	virtual void calcTimeVectors(const PairType&,
 	                             RealType,
@@ -106,6 +106,7 @@ class TimeVectorsChebyshev : public  TimeVectorsBase<TargetParamsType,
 	LanczosSolverType,
 	VectorWithOffsetType> BaseType;
 	typedef typename BaseType::PairType PairType;
+	typedef typename BaseType::LanczosMatrixCacheType LanczosMatrixCacheType;
 	typedef typename TargetParamsType::RealType RealType;
 	typedef typename PsimagLite::Vector<RealType>::Type VectorRealType;
 	typedef typename ModelType::ModelHelperType ModelHelperType;
@@ -139,6 +140,7 @@ public:
 	                     const ModelType& model,
 	                     const WaveFunctionTransfType& wft,
 	                     const LeftRightSuperType& lrs,
+	                     const LanczosMatrixCacheType& lanczosMatrices,
 	                     const RealType& E0,
 	                     InputValidatorType& ioIn)
 	    : currentTime_(currentTime),
@@ -147,6 +149,7 @@ public:
 	      model_(model),
 	      wft_(wft),
 	      lrs_(lrs),
+	      lanczosMatrices_(lanczosMatrices),
 	      E0_(E0),
 	      ioIn_(ioIn),
 	      timeHasAdvanced_(false)
@@ -229,14 +232,9 @@ private:
 	                      const TargetParamsType& tstStruct)
 	{
 		SizeType p = lrs_.super().findPartitionNumber(phi.offset(i0));
-		typename ModelType::HamiltonianConnectionType hc(p,
-		                                                 lrs_,
-		                                                 model_.geometry(),
-		                                                 ModelType::modelLinks(),
-		                                                 currentTime_,
-		                                                 0);
-		MatrixLanczosType lanczosHelper(model_,
-		                                hc);
+		const typename LanczosMatrixCacheType::BuiltPtrType built =
+		        lanczosMatrices_(p, currentTime_);
+		const MatrixLanczosType& lanczosHelper = built->matrix();
 
 		ProgramGlobals::VerboseEnum verbose = (model_.params().options.find("VerboseCheby")
 		                                       != PsimagLite::String::npos)
@@ -267,6 +265,7 @@ private:
 	const ModelType& model_;
 	const WaveFunctionTransfType& wft_;
 	const LeftRightSuperType& lrs_;
+	const LanczosMatrixCacheType& lanczosMatrices_;
 	const RealType& E0_;
 	InputValidatorType& ioIn_;
 	bool timeHasAdvanced_;
@@ -106,6 +106,7 @@ class TimeVectorsKrylov : public  TimeVectorsBase<
 	LanczosSolverType,
 	VectorWithOffsetType> BaseType;
 	typedef typename BaseType::PairType PairType;
+	typedef typename BaseType::LanczosMatrixCacheType LanczosMatrixCacheType;
 	typedef typename TargetParamsType::RealType RealType;
 	typedef typename PsimagLite::Vector<RealType>::Type VectorRealType;
 	typedef typename ModelType::ModelHelperType ModelHelperType;
@@ -135,6 +136,7 @@ public:
 	                  const ModelType& model,
 	                  const WaveFunctionTransfType& wft,
 	                  const LeftRightSuperType& lrs,
+	                  const LanczosMatrixCacheType& lanczosMatrices,
 	                  const RealType& E0,
 	                  InputValidatorType& ioIn)
 	    : currentTime_(currentTime),
@@ -143,6 +145,7 @@ public:
 	      model_(model),
 	      wft_(wft),
 	      lrs_(lrs),
+	      lanczosMatrices_(lanczosMatrices),
 	      E0_(E0),
 	      ioIn_(ioIn),
 	      timeHasAdvanced_(true)
@@ -306,7 +309,14 @@ private:
 		typedef PsimagLite::NoPthreadsNg<ParallelTriDiagType> ParallelizerType;
 		ParallelizerType threadedTriDiag(PsimagLite::CodeSectionParams(1));
 
-		ParallelTriDiagType helperTriDiag(phi,T,V,steps,lrs_,currentTime_,model_,ioIn_);
+		ParallelTriDiagType helperTriDiag(phi,
+		                                  T,
+		                                  V,
+		                                  steps,
+		                                  lrs_,
+		                                  currentTime_,
+		                                  lanczosMatrices_,
+		                                  ioIn_);
 
 		threadedTriDiag.loopCreate(helperTriDiag);
 	}
@@ -317,6 +327,7 @@ private:
 	const ModelType& model_;
 	const WaveFunctionTransfType& wft_;
 	const LeftRightSuperType& lrs_;
+	const LanczosMatrixCacheType& lanczosMatrices_;
 	const RealType& E0_;
 	InputValidatorType& ioIn_;
 	bool timeHasAdvanced_;
@@ -114,6 +114,7 @@ class TimeVectorsRungeKutta : public  TimeVectorsBase<
 	LanczosSolverType,
 	VectorWithOffsetType> BaseType;
 	typedef typename BaseType::PairType PairType;
+	typedef typename BaseType::LanczosMatrixCacheType LanczosMatrixCacheType;
 	typedef typename TargetParamsType::RealType RealType;
 	typedef typename ModelType::ModelHelperType ModelHelperType;
 	typedef typename ModelHelperType::LeftRightSuperType LeftRightSuperType;
@@ -133,6 +134,7 @@ public:
 						  const ModelType& model,
 						  const WaveFunctionTransfType& wft,
 						  const LeftRightSuperType& lrs,
+						  const LanczosMatrixCacheType& lanczosMatrices,
 						  const RealType& E0)
 		: progress_("TimeVectorsRungeKutta"),
 		  currentTime_(currentTime),
@@ -141,6 +143,7 @@ public:
 		  model_(model),
 		  wft_(wft),
 		  lrs_(lrs),
+		  lanczosMatrices_(lanczosMatrices),
 		  E0_(E0)
 	{}
 
@@ -179,14 +182,14 @@ private:
 		                      const RealType &timeDirection,
 		                      const LeftRightSuperType& lrs,
 		                      RealType currentTime,
-		                      const ModelType& model,
+		                      const LanczosMatrixCacheType& lanczosMatrices,
 		                      const VectorWithOffsetType& phi,
 		                      SizeType i0)
 			: E0_(E0),
 		      timeDirection_(timeDirection),
 			  p_(lrs.super().findPartitionNumber(phi.offset(i0))),
-		      hc_(p_, lrs, model.geometry(), ModelType::modelLinks(), currentTime, 0),
-			  lanczosHelper_(model, hc_)
+			  built_(lanczosMatrices(p_, currentTime)),
+			  lanczosHelper_(built_->matrix())
 		{}
 
 		TargetVectorType operator()(const RealType&,const TargetVectorType& y) const
@@ -206,8 +209,8 @@ private:
 		RealType E0_;
 		RealType timeDirection_;
 		SizeType p_;
-		typename ModelType::HamiltonianConnectionType hc_;
-		typename LanczosSolverType::MatrixType lanczosHelper_;
+		const typename LanczosMatrixCacheType::BuiltPtrType built_;
+		const typename LanczosSolverType::MatrixType& lanczosHelper_;
 	}; // FunctionForRungeKutta
 
 	void calcTimeVectors(const PairType& startEnd,
@@ -220,7 +223,13 @@ private:
 		SizeType total = phi.effectiveSize(i0);
 		TargetVectorType phi0(total);
 		phi.extract(phi0,i0);
-		FunctionForRungeKutta f(E0_,tstStruct.timeDirection(),lrs_,currentTime_,model_,phi,i0);
+		FunctionForRungeKutta f(E0_,
+		                        tstStruct.timeDirection(),
+		                        lrs_,
+		                        currentTime_,
+		                        lanczosMatrices_,
+		                        phi,
+		                        i0);
 
 		RealType epsForRK = tstStruct.tau()/(times_.size()-1.0);
 		PsimagLite::RungeKutta<RealType,FunctionForRungeKutta,TargetVectorType>
@@ -242,6 +251,7 @@ private:
 	const ModelType& model_;
 	const WaveFunctionTransfType& wft_;
 	const LeftRightSuperType& lrs_;
+	const LanczosMatrixCacheType& lanczosMatrices_;
 	RealType E0_;
 }; //class TimeVectorsRungeKutta
 } // namespace Dmrg
@@ -281,15 +281,13 @@ private:
 			cache.transform.setTo(1.0);
 		}
 
-		rSprime = pBasis;
+		rSprime.copyForTruncation(pBasis, operatorsToKeep(direction));
 		rSprime.changeBasis(cache.removedIndices,cache.eigs,keptStates,parameters_);
 	}
 
-	void truncateBasis(BasisWithOperatorsType& rPrime,
-	                   const BasisWithOperatorsType& oppoBasis,
-	                   const DensityMatrixBaseType& dms,
-	                   ProgramGlobals::DirectionEnum direction,
-	                   SizeType keptStates)
+	// operators of the most recently added sites, the only ones that
+	// need to be transformed into the truncated basis
+	PairSizeSizeType operatorsToKeep(ProgramGlobals::DirectionEnum direction) const
 	{
 		bool expandSys = (direction == ProgramGlobals::DirectionEnum::EXPAND_SYSTEM);
 		const BasisWithOperatorsType& basis = (expandSys) ? lrs_.left() : lrs_.right();
@@ -302,6 +300,18 @@ private:
 			else startEnd.second = mostRecent;
 		}
 
+		return startEnd;
+	}
+
+	void truncateBasis(BasisWithOperatorsType& rPrime,
+	                   const BasisWithOperatorsType& oppoBasis,
+	                   const DensityMatrixBaseType& dms,
+	                   ProgramGlobals::DirectionEnum direction,
+	                   SizeType keptStates)
+	{
+		bool expandSys = (direction == ProgramGlobals::DirectionEnum::EXPAND_SYSTEM);
+		const PairSizeSizeType startEnd = operatorsToKeep(direction);
+
 		PsimagLite::OstringStream msg;
 		TruncationCache& cache = (expandSys) ? leftCache_ : rightCache_;
 
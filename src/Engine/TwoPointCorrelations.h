@@ -108,6 +108,8 @@ public:
 	typedef typename ObserverHelperType::MatrixType MatrixType;
 	typedef Parallel2PointCorrelations<ThisType> Parallel2PointCorrelationsType;
 	typedef typename Parallel2PointCorrelationsType::PairType PairType;
+	typedef typename Parallel2PointCorrelationsType::VectorItemType VectorItemType;
+	typedef typename PsimagLite::Vector<PairType>::Type VectorPairType;
 
 	TwoPointCorrelations(const CorrelationsSkeletonType& skeleton) : skeleton_(skeleton)
 	{}
@@ -119,28 +121,54 @@ public:
 	                PsimagLite::String bra,
 	                PsimagLite::String ket) const
 	{
-		SizeType rows = w.n_row();
-		SizeType cols = w.n_col();
+		fillRows(w, 0, O1, O2, fermionicSign, bra, ket);
+	}
 
-		typename PsimagLite::Vector<PairType>::Type pairs;
-		for (SizeType i=0;i<rows;i++) {
-			for (SizeType j=i;j<cols;j++) {
-				if (i>j) continue;
-				pairs.push_back(PairType(i,j));
-			}
-		}
+	// Rows offset, offset + 1, ... of the matrix of operator(),
+	// as rows 0, 1, ... of w
+	void fillRows(PsimagLite::Matrix<FieldType>& w,
+	              SizeType offset,
+	              const SparseMatrixType& O1,
+	              const SparseMatrixType& O2,
+	              ProgramGlobals::FermionOrBosonEnum fermionicSign,
+	              PsimagLite::String bra,
+	              PsimagLite::String ket) const
+	{
+		VectorPairType pairs;
+		findPairs(pairs, offset, w.n_row() + offset, w.n_col());
 
 		typedef PsimagLite::Parallelizer<Parallel2PointCorrelationsType> ParallelizerType;
 		ParallelizerType threaded2Points(PsimagLite::Concurrency::codeSectionParams);
 
+		// brackets run inside the threads of this loop
+		const CorrelationsSkeletonType skeletonInThreads(skeleton_, 1);
+		const ThisType twopointInThreads(skeletonInThreads);
 		Parallel2PointCorrelationsType helper2Points(w,
-		                                             *this,
+		                                             twopointInThreads,
 		                                             pairs,
 		                                             O1,
 		                                             O2,
 		                                             fermionicSign,
 		                                             bra,
-		                                             ket);
+		                                             ket,
+		                                             offset);
+
+		threaded2Points.loopCreate(helper2Points);
+	}
+
+	// Many correlations at once, each matrix of items of size rows times cols;
+	// threads go over pairs of sites, and all items are computed for a pair
+	void operator()(const VectorItemType& items, SizeType rows, SizeType cols) const
+	{
+		VectorPairType pairs;
+		findPairs(pairs, 0, rows, cols);
+
+		typedef PsimagLite::Parallelizer<Parallel2PointCorrelationsType> ParallelizerType;
+		ParallelizerType threaded2Points(PsimagLite::Concurrency::codeSectionParams);
+
+		const CorrelationsSkeletonType skeletonInThreads(skeleton_, 1);
+		const ThisType twopointInThreads(skeletonInThreads);
+		Parallel2PointCorrelationsType helper2Points(twopointInThreads, pairs, items);
 
 		threaded2Points.loopCreate(helper2Points);
 	}
@@ -171,6 +199,16 @@ public:
 
 private:
 
+	static void findPairs(VectorPairType& pairs, SizeType offset, SizeType rows, SizeType cols)
+	{
+		for (SizeType i=offset;i<rows;i++) {
+			for (SizeType j=i;j<cols;j++) {
+				if (i>j) continue;
+				pairs.push_back(PairType(i,j));
+			}
+		}
+	}
+
 	FieldType calcDiagonalCorrelation(SizeType i,
 	                                  const SparseMatrixType& O1,
 	                                  const SparseMatrixType& O2,
@@ -219,6 +257,7 @@ private:
 		if (j == skeleton_.numberOfSites() - 1) {
 			if (i == j - 1) {
 				const SizeType ptr = j - 2;
+				typename ObserverHelperType::StepPin pin(helper, ptr);
 				SizeType ni = helper.leftRightSuper(ptr).left().size()/
 				        helper.leftRightSuper(ptr).right().size();
 
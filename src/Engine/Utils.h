@@ -146,19 +146,6 @@ truncateVector(SomeVectorType& v,
 	v = tmpVector;
 }
 
-template<typename SomeVectorType>
-static
-typename PsimagLite::EnableIf<PsimagLite::IsVectorLike<SomeVectorType>::True,void>::Type
-fillFermionicSigns(SomeVectorType& fermionicSigns,
-                   const PsimagLite::Vector<bool>::Type& signs,
-                   int f)
-{
-	typedef typename SomeVectorType::value_type ValueType;
-	fermionicSigns.resize(signs.size());
-	for (SizeType i=0;i<fermionicSigns.size();i++)
-		fermionicSigns[i]= (signs[i]) ? static_cast<ValueType>(f) : 1;
-}
-
 SizeType exactDivision(SizeType,SizeType);
 
 SizeType bitSizeOfInteger(SizeType);
@@ -85,6 +85,7 @@ DISCLOSED WOULD NOT INFRINGE PRIVATELY OWNED RIGHTS.
 #include <cassert>
 #include "ProgramGlobals.h"
 #include <typeinfo>
+#include <algorithm>
 
 // FIXME: a more generic solution is needed instead of tying
 // the non-zero structure to basis
@@ -107,7 +108,7 @@ public:
 	typedef typename PsimagLite::Vector<ComplexOrRealType>::Type VectorType;
 
 	VectorWithOffsets()
-	    : progress_("VectorWithOffsets"),size_(0),index2Sector_(0)
+	    : progress_("VectorWithOffsets"),size_(0)
 	{ }
 
 	template<typename SomeBasisType>
@@ -115,7 +116,6 @@ public:
 	                  const SomeBasisType& someBasis)
 	    : progress_("VectorWithOffsets"),
 	      size_(someBasis.size()),
-	      index2Sector_(size_),
 	      data_(weights.size()),
 	      offsets_(weights.size()+1)
 	{
@@ -136,7 +136,7 @@ public:
 	void clear()
 	{
 		size_ = 0;
-		index2Sector_.clear();
+		nonZeroSector_.clear();
 		data_.clear();
 		offsets_.clear();
 		nzMsAndQns_.clear();
@@ -346,15 +346,15 @@ public:
 
 	const ComplexOrRealType& slowAccess(SizeType i) const
 	{
-		assert(i<index2Sector_.size());
-		int j = index2Sector_[i];
+		assert(i < size_);
+		int j = index2Sector(i);
 		if (j<0) return zero_;
 		return data_[j][i-offsets_[j]];
 	}
 
 	ComplexOrRealType& slowAccess(SizeType i)
 	{
-		int j = index2Sector_[i];
+		int j = index2Sector(i);
 		if (j<0) {
 			PsimagLite::String msg("VectorWithOffsets");
 			std::cerr<<msg<<" can't build itself dynamically yet (sorry!)\n";
@@ -384,7 +384,6 @@ public:
 	{
 		io.read(size_, label + "/size_");
 		if (size_ == 0) return;
-		io.read(index2Sector_, label + "/index2Sector_");
 		SizeType x = 0;
 		io.read(x, label + "/data_/Size");
 		data_.resize(x);
@@ -407,6 +406,8 @@ public:
 			io.read(nzMsAndQns_[i].first, label + "/nzMsAndQns_/" + ttos(i) + "/0");
 			nzMsAndQns_[i].second.read(label + "/nzMsAndQns_/" + ttos(i) + "/1", io);
 		}
+
+		setIndex2Sector();
 	}
 
 	template<typename SomeIoOutputType>
@@ -415,7 +416,6 @@ public:
 	{
 		io.createGroup(label);
 		io.write(size_, label + "/size_");
-		io.write(index2Sector_, label + "/index2Sector_");
 		io.write(data_, label + "/data_");
 		io.write(offsets_, label + "/offsets_");
 		io.write(nzMsAndQns_, label + "/nzMsAndQns_");
@@ -487,10 +487,18 @@ public:
 		return *this;
 	}
 
+	// sector of index i, or -1 if i is in a zero sector;
+	// finds the partition of i in offsets_ with a binary search
 	int index2Sector(SizeType i) const
 	{
-		assert(i < index2Sector_.size());
-		return index2Sector_[i];
+		assert(i < size_);
+		typename VectorSizeType::const_iterator it = std::upper_bound(offsets_.begin(),
+		                                                              offsets_.end(),
+		                                                              i);
+		if (it == offsets_.begin() || it == offsets_.end()) return -1;
+		const SizeType j = (it - offsets_.begin()) - 1;
+		if (j >= nonZeroSector_.size() || !nonZeroSector_[j]) return -1;
+		return j;
 	}
 
 	friend RealType norm(const VectorWithOffsets& v)
@@ -576,20 +584,15 @@ public:
 
 private:
 
+	// one flag per partition, not per index
 	void setIndex2Sector()
 	{
-		if (index2Sector_.size()!=size_)
-			index2Sector_.resize(size_);
-
-		for (SizeType i = 0; i < size_; ++i) {
-			index2Sector_[i] = -1;
-			for (SizeType jj = 0; jj < nzMsAndQns_.size(); ++jj) {
-				SizeType j = nzMsAndQns_[jj].first;
-				assert(j + 1 < offsets_.size());
-				if (i < offsets_[j] || i >= offsets_[j+1])
-					continue;
-				index2Sector_[i] = j;
-			}
+		nonZeroSector_.assign(data_.size(), false);
+		for (SizeType jj = 0; jj < nzMsAndQns_.size(); ++jj) {
+			SizeType j = nzMsAndQns_[jj].first;
+			assert(j + 1 < offsets_.size());
+			assert(j < nonZeroSector_.size());
+			nonZeroSector_[j] = true;
 		}
 	}
 
@@ -651,7 +654,7 @@ private:
 
 	PsimagLite::ProgressIndicator progress_;
 	SizeType size_;
-	typename PsimagLite::Vector<int>::Type index2Sector_;
+	typename PsimagLite::Vector<bool>::Type nonZeroSector_;
 	typename PsimagLite::Vector<VectorType>::Type data_;
 	typename PsimagLite::Vector<SizeType>::Type offsets_;
 	typename PsimagLite::Vector<PairQnType>::Type nzMsAndQns_;
@@ -0,0 +1,244 @@
+#include "util.h"
+#include "KronUtil.h"
+#include "PsiApp.h"
+#include "Parallelizer.h"
+#include "ProgressIndicator.h"
+
+#ifndef USE_FLOAT
+typedef double RealType;
+#else
+typedef float RealType;
+#endif
+
+/*
+ * ---------------------------------------------------------------
+ * Microbenchmark for the kronecker product kernels of KronUtil,
+ * den_kron_mult, csr_kron_mult, csr_den_kron_mult and den_csr_kron_mult.
+ * BatchedGemm2 and the matrix vector engines of DMRG++ need a model and
+ * a superblock, so they are timed by src/matrixVectorBench.cpp instead,
+ * on a step loaded from the checkpoint of a previous run.
+ *
+ * Usage: bench1 [maximum threads] [products per thread]
+ *
+ * Every task does one product into the output vector of its thread,
+ * so that timings with more threads measure throughput scaling.
+ * Flops are those of the method that estimate_kron_cost picks with
+ * the same denseFlopDiscount given to the kernel, counted without discount;
+ * bytes are the operands plus reading Y and updating X once.
+ * ---------------------------------------------------------------
+ */
+
+typedef PsimagLite::Matrix<RealType> MatrixType;
+typedef PsimagLite::CrsMatrix<RealType> SparseMatrixType;
+typedef PsimagLite::Vector<RealType>::Type VectorType;
+typedef PsimagLite::Vector<VectorType>::Type VectorVectorType;
+typedef PsimagLite::MemoryUsage::TimeHandle TimeHandle;
+
+static const RealType denseFlopDiscount = 0.2;
+
+// nnz_A and nnz_B are what the kernel gives to estimate_kron_cost,
+// work_A and work_B are the entries it actually multiplies
+static RealType kronFlops(int nrow_A, int ncol_A, int nnz_A, RealType work_A,
+                          int nrow_B, int ncol_B, int nnz_B, RealType work_B)
+{
+	RealType kron_nnz = 0;
+	RealType kron_flops = 0;
+	int imethod = 0;
+	estimate_kron_cost(nrow_A, ncol_A, nnz_A, nrow_B, ncol_B, nnz_B,
+	                   &kron_nnz, &kron_flops, &imethod, denseFlopDiscount);
+	switch (imethod) {
+	case 1:
+		return 2.0*work_B*ncol_A + 2.0*work_A*nrow_B;
+	case 2:
+		return 2.0*work_A*ncol_B + 2.0*work_B*nrow_A;
+	default:
+		return 2.0*work_A*work_B;
+	}
+}
+
+static RealType denseBytes(const MatrixType& a)
+{
+	return static_cast<RealType>(a.n_row())*a.n_col()*sizeof(RealType);
+}
+
+static RealType sparseBytes(const SparseMatrixType& a)
+{
+	return static_cast<RealType>(a.nonZeros())*(sizeof(RealType) + sizeof(int)) +
+	        (a.rows() + 1)*sizeof(int);
+}
+
+class BenchKernel {
+
+public:
+
+	enum KernelEnum {DEN_DEN, CSR_CSR, CSR_DEN, DEN_CSR, KERNELS};
+
+	BenchKernel(KernelEnum kernel,
+	            const MatrixType& aDense,
+	            const MatrixType& bDense,
+	            SizeType products,
+	            SizeType threads)
+	    : kernel_(kernel),
+	      a_(aDense),
+	      b_(bDense),
+	      aSparse_(aDense),
+	      bSparse_(bDense),
+	      y_(aDense.n_col()*bDense.n_col()),
+	      x_(PsimagLite::Concurrency::storageSize(threads)),
+	      products_(products)
+	{
+		for (SizeType i = 0; i < y_.size(); ++i)
+			y_[i] = rand()/static_cast<RealType>(RAND_MAX);
+
+		for (SizeType i = 0; i < x_.size(); ++i)
+			x_[i].resize(a_.n_row()*b_.n_row(), 0.0);
+	}
+
+	void doTask(SizeType, SizeType threadNum)
+	{
+		VectorType& x = x_[threadNum];
+		switch (kernel_) {
+		case DEN_DEN:
+			den_kron_mult('N', 'N', a_, b_, y_, 0, x, 0, denseFlopDiscount);
+			break;
+		case CSR_CSR:
+			csr_kron_mult('N', 'N', aSparse_, bSparse_, y_, 0, x, 0, denseFlopDiscount);
+			break;
+		case CSR_DEN:
+			csr_den_kron_mult('N', 'N', aSparse_, b_, y_, 0, x, 0, denseFlopDiscount);
+			break;
+		default:
+			den_csr_kron_mult('N', 'N', a_, bSparse_, y_, 0, x, 0, denseFlopDiscount);
+			break;
+		}
+	}
+
+	SizeType tasks() const { return products_; }
+
+	RealType flops() const
+	{
+		const bool denseA = (kernel_ == DEN_DEN || kernel_ == DEN_CSR);
+		const bool denseB = (kernel_ == DEN_DEN || kernel_ == CSR_DEN);
+		const int sizeA = a_.n_row()*a_.n_col();
+		const int sizeB = b_.n_row()*b_.n_col();
+		const int nnzA = (kernel_ == DEN_DEN) ? sizeA : aSparse_.nonZeros();
+		const int nnzB = (kernel_ == DEN_DEN) ? sizeB : bSparse_.nonZeros();
+		return kronFlops(a_.n_row(), a_.n_col(), nnzA, (denseA) ? sizeA : nnzA,
+		                 b_.n_row(), b_.n_col(), nnzB, (denseB) ? sizeB : nnzB);
+	}
+
+	RealType bytes() const
+	{
+		const bool denseA = (kernel_ == DEN_DEN || kernel_ == DEN_CSR);
+		const bool denseB = (kernel_ == DEN_DEN || kernel_ == CSR_DEN);
+		RealType sum = (denseA) ? denseBytes(a_) : sparseBytes(aSparse_);
+		sum += (denseB) ? denseBytes(b_) : sparseBytes(bSparse_);
+		return sum + (y_.size() + 2*x_[0].size())*sizeof(RealType);
+	}
+
+	static PsimagLite::String name(KernelEnum kernel)
+	{
+		switch (kernel) {
+		case DEN_DEN:
+			return "den_kron_mult";
+		case CSR_CSR:
+			return "csr_kron_mult";
+		case CSR_DEN:
+			return "csr_den_kron_mult";
+		default:
+			return "den_csr_kron_mult";
+		}
+	}
+
+private:
+
+	KernelEnum kernel_;
+	const MatrixType& a_;
+	const MatrixType& b_;
+	SparseMatrixType aSparse_;
+	SparseMatrixType bSparse_;
+	VectorType y_;
+	VectorVectorType x_;
+	SizeType products_;
+};
+
+template<typename HelperType>
+void timeAndPrint(HelperType& helper,
+                  PsimagLite::String name,
+                  PsimagLite::String shape,
+                  SizeType threads)
+{
+	typedef PsimagLite::Parallelizer<HelperType> ParallelizerType;
+
+	// warm up caches and any workspace of the kernel
+	helper.doTask(0, 0);
+
+	PsimagLite::CodeSectionParams codeSectionParams(threads);
+	ParallelizerType parallelizer(codeSectionParams);
+	const TimeHandle start = PsimagLite::ProgressIndicator::time();
+	parallelizer.loopCreate(helper);
+	const RealType seconds = (PsimagLite::ProgressIndicator::time() - start).seconds();
+
+	const RealType products = helper.tasks();
+	const RealType gflops = (seconds > 0) ? 1e-9*products*helper.flops()/seconds : 0;
+	const RealType gbytes = (seconds > 0) ? 1e-9*products*helper.bytes()/seconds : 0;
+	printf("%-18s %-32s threads=%-3d seconds=%-10.4g GFLOP/s=%-10.4g GB/s=%-10.4g\n",
+	       name.c_str(),
+	       shape.c_str(),
+	       static_cast<int>(threads),
+	       seconds,
+	       gflops,
+	       gbytes);
+}
+
+static PsimagLite::String describe(const SparseMatrixType& a, const SparseMatrixType& b)
+{
+	PsimagLite::OstringStream msg;
+	msg<<"A="<<a.rows()<<"x"<<a.cols()<<"("<<a.nonZeros()<<")";
+	msg<<" B="<<b.rows()<<"x"<<b.cols()<<"("<<b.nonZeros()<<")";
+	return msg.str();
+}
+
+int main(int argc, char **argv)
+{
+	PsimagLite::PsiApp application("bench1", &argc, &argv, 1);
+
+	const SizeType maxThreads = (argc > 1) ? atoi(argv[1]) : 1;
+	const SizeType products = (argc > 2) ? atoi(argv[2]) : 16;
+	if (maxThreads == 0 || products == 0) {
+		fprintf(stderr, "USAGE: %s [maximum threads] [products per thread]\n", argv[0]);
+		return 1;
+	}
+
+	srand(1234);
+
+	/*
+	 * ------------------------------------------
+	 * kernels on a grid of shapes and sparsities
+	 * ------------------------------------------
+	 */
+	const int sizes[] = {16, 64, 256};
+	const RealType thresholds[] = {0.01, 0.1, 1.1};
+	for (SizeType is = 0; is < 3; ++is) {
+		for (SizeType ta = 0; ta < 3; ++ta) {
+			for (SizeType tb = 0; tb < 3; ++tb) {
+				MatrixType a_(sizes[is], sizes[is]);
+				MatrixType b_(sizes[is], sizes[is]);
+				den_gen_matrix(sizes[is], sizes[is], thresholds[ta], a_);
+				den_gen_matrix(sizes[is], sizes[is], thresholds[tb], b_);
+				const PsimagLite::String shape = describe(SparseMatrixType(a_),
+				                                          SparseMatrixType(b_));
+
+				for (SizeType k = 0; k < BenchKernel::KERNELS; ++k) {
+					const BenchKernel::KernelEnum kernel = static_cast<BenchKernel::KernelEnum>(k);
+					for (SizeType threads = 1; threads <= maxThreads; threads *= 2) {
+						BenchKernel helper(kernel, a_, b_, products*threads, threads);
+						timeAndPrint(helper, BenchKernel::name(kernel), shape, threads);
+					}
+				}
+			}
+		}
+	}
+
+	return 0;
+}
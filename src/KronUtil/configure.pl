@@ -53,7 +53,7 @@ sub createMakefile
 
 	my %args;
 	$args{"code"} = "KronUtil";
-	$args{"additional3"} = "libkronutil.a test1 test2";
+	$args{"additional3"} = "libkronutil.a test1 test2 bench1";
 	$args{"path"} = "../";
 	$args{"configFiles"} = getConfigFiles($cfiles);
 	$args{"flavor"} = $flavor;
@@ -72,6 +72,9 @@ test1: libkronutil.a test1.o $dotos
 test2: libkronutil.a test2.o
 	\$(CXX) \$(CFLAGS) -o test2 test2.o libkronutil.a \$(LDFLAGS)
 
+bench1: libkronutil.a bench1.o
+	\$(CXX) \$(CFLAGS) -o bench1 bench1.o libkronutil.a \$(LDFLAGS)
+
 EOF
 
 	close($fh);
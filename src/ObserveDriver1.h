@@ -75,17 +75,18 @@ bool observeOneFullSweep(IoInputType& io,
 	                                  nf,
 	                                  trail);
 
+	// brakets and labels are measured together; the output keeps the input order
+	PsimagLite::Vector<PsimagLite::String>::Type items;
 	for (SizeType i = 0; i < vecOptions.size(); ++i) {
 		PsimagLite::String item = vecOptions[i];
 
 		if (item.find("%") == 0) continue;
 
-		if (item.length() > 0 && item[0] != '<')
-			observerLib.measure(item, rows, cols, orbitals);
-		else
-			observerLib.interpret(item, rows, cols);
+		items.push_back(item);
 	}
 
+	observerLib.interpret(items, rows, cols, orbitals);
+
 	start = end;
 	return observerLib.endOfData();
 }
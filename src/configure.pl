@@ -58,6 +58,9 @@ my %qnDriver = (name => 'Qn', aux => 1);
 my %su2RelatedDriver = (name => 'Su2Related', aux => 1);
 my %toolboxDriver = (name => 'toolboxdmrg',
                      dotos => 'toolboxdmrg.o ProgramGlobals.o Provenance.o Utils.o Qn.o');
+my %matrixVectorBenchDriver = (name => 'matrixVectorBench',
+                               dotos => 'matrixVectorBench.o ProgramGlobals.o Provenance.o Utils.o Su2Related.o Qn.o',
+                               libs => "kronutil");
 my $dotos = "observe.o ProgramGlobals.o Provenance.o Utils.o Su2Related.o Qn.o ";
 $dotos .= " ObserveDriver0.o ObserveDriver1.o ObserveDriver2.o ";
 my %observeDriver = (name => 'observe', dotos => $dotos);
@@ -68,7 +71,7 @@ my %observeDriver2 = (name => 'ObserveDriver2', aux => 1);
 
 my @drivers = (\%provenanceDriver,\%su2RelatedDriver,
 \%progGlobalsDriver,\%restartDriver,\%finiteLoopDriver,\%utilsDriver,
-\%qnDriver, \%observeDriver,\%toolboxDriver,
+\%qnDriver, \%observeDriver,\%toolboxDriver,\%matrixVectorBenchDriver,
 \%observeDriver0,\%observeDriver1,\%observeDriver2);
 
 $dotos = "dmrg.o Provenance.o RestartStruct.o FiniteLoop.o Utils.o Qn.o ";
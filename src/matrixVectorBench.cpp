@@ -0,0 +1,299 @@
+#include <unistd.h>
+#define USE_PTHREADS_OR_NOT_NG
+#include "ProgramGlobals.h"
+#include "InputNg.h"
+#include "InputCheck.h"
+#include "ParametersDmrgSolver.h"
+#include "Provenance.h"
+#include "ModelSelector.h"
+#include "Geometry/Geometry.h"
+#include "ModelHelperLocal.h"
+#include "MatrixVectorOnTheFly.h"
+#include "MatrixVectorStored.h"
+#include "MatrixVectorKron/MatrixVectorKron.h"
+#include "MatrixVectorEngineSelector.h"
+#include "BasisWithOperators.h"
+#include "LeftRightSuper.h"
+#include "Operators.h"
+#include "CrsMatrix.h"
+#include "ModelBase.h"
+#include "Io/IoSelector.h"
+#include "PsimagLite.h"
+#include "Qn.h"
+
+#ifndef USE_FLOAT
+typedef double RealType;
+#else
+typedef float RealType;
+#endif
+
+typedef PsimagLite::InputNg<Dmrg::InputCheck> InputNgType;
+typedef Dmrg::ParametersDmrgSolver<RealType,InputNgType::Readable, Dmrg::Qn>
+ParametersDmrgSolverType;
+typedef PsimagLite::Concurrency ConcurrencyType;
+typedef PsimagLite::MemoryUsage::TimeHandle TimeHandle;
+
+/*
+ * ---------------------------------------------------------------
+ * Benchmark of the matrix vector engines of DMRG++ on a real step.
+ * The system and environ blocks are loaded from the checkpoint
+ * (CHKPOINTSYSTEM and CHKPOINTENVIRON) of the file given by OutputFile=,
+ * that is, of a previous run of dmrg with the same input.
+ * The superblock is their product in the target sector, and the
+ * largest symmetry sector is used for all engines. For each of
+ * MatrixVectorStored, MatrixVectorKron, MatrixVectorKron with BatchedGemm
+ * (that is, with the products done by BatchedGemm2) and MatrixVectorOnTheFly,
+ * the setup is timed once and then the given number of products.
+ * Flops and bytes are the estimates of MatrixVectorEngineSelector.
+ * ---------------------------------------------------------------
+ */
+
+template<typename MatrixVectorType, typename ModelType>
+void timeEngine(const PsimagLite::String& name,
+                const ModelType& model,
+                const typename ModelType::HamiltonianConnectionType& hc,
+                typename Dmrg::MatrixVectorEngineSelector<ModelType>::EngineEnum engine,
+                SizeType products)
+{
+	typedef Dmrg::MatrixVectorEngineSelector<ModelType> MatrixVectorEngineSelectorType;
+	typedef typename MatrixVectorType::VectorType VectorType;
+
+	const TimeHandle start = PsimagLite::ProgressIndicator::time();
+	MatrixVectorType matrix(model, hc);
+	const RealType setup = (PsimagLite::ProgressIndicator::time() - start).seconds();
+
+	const SizeType n = matrix.rows();
+	VectorType y(n);
+	VectorType x(n, 0.0);
+	PsimagLite::fillRandom(y);
+
+	// warm up caches and any workspace of the engine
+	matrix.matrixVectorProduct(x, y);
+
+	const TimeHandle start2 = PsimagLite::ProgressIndicator::time();
+	for (SizeType i = 0; i < products; ++i)
+		matrix.matrixVectorProduct(x, y);
+	const RealType seconds = (PsimagLite::ProgressIndicator::time() - start2).seconds();
+
+	MatrixVectorEngineSelectorType selector(model, hc);
+	const RealType perProduct = (products > 0) ? seconds/products : 0;
+	const RealType flops = selector.flopsPerProduct(engine);
+	const RealType bytes = selector.bytesKept(engine);
+	const RealType gflops = (perProduct > 0) ? 1e-9*flops/perProduct : 0;
+	printf("%-22s n=%-10d setup=%-10.4g seconds/product=%-10.4g GFLOP/s=%-10.4g MB=%-10.4g\n",
+	       name.c_str(),
+	       static_cast<int>(n),
+	       setup,
+	       perProduct,
+	       gflops,
+	       bytes/(1024.0*1024.0));
+}
+
+template<typename ModelType>
+void benchStep(const ModelType& model,
+               ParametersDmrgSolverType& params,
+               SizeType products)
+{
+	typedef typename ModelType::ModelHelperType ModelHelperType;
+	typedef typename ModelHelperType::LeftRightSuperType LeftRightSuperType;
+	typedef typename LeftRightSuperType::BasisWithOperatorsType BasisWithOperatorsType;
+	typedef typename LeftRightSuperType::BasisType BasisType;
+	typedef typename ModelType::HamiltonianConnectionType HamiltonianConnectionType;
+	typedef Dmrg::MatrixVectorEngineSelector<ModelType> MatrixVectorEngineSelectorType;
+
+	PsimagLite::IoSelector::In io(params.filename);
+	BasisWithOperatorsType pS(io, "CHKPOINTSYSTEM", false);
+	BasisWithOperatorsType pE(io, "CHKPOINTENVIRON", false);
+	io.close();
+
+	BasisType super("MatrixVectorBench.Super");
+	LeftRightSuperType lrs(pS, pE, super);
+	const SizeType ten = 10;
+	lrs.setToProduct(model.targetQuantum().qn, std::max(ten, params.keptStatesInfinite));
+	lrs.printSizes("MatrixVectorBench", std::cout);
+
+	SizeType sector = 0;
+	for (SizeType m = 1; m + 1 < lrs.super().partition(); ++m) {
+		const SizeType size = lrs.super().partition(m + 1) - lrs.super().partition(m);
+		if (size > lrs.super().partition(sector + 1) - lrs.super().partition(sector))
+			sector = m;
+	}
+
+	const RealType time = 0;
+	HamiltonianConnectionType hc(sector,
+	                             lrs,
+	                             model.geometry(),
+	                             ModelType::modelLinks(),
+	                             time,
+	                             0);
+	hc.buildOperators();
+	std::cout<<"MatrixVectorBench: sector "<<sector<<" of size "<<hc.modelHelper().size();
+	std::cout<<" with "<<hc.tasks()<<" links, "<<products<<" products per engine\n";
+
+	// each engine is used as is: no engine selection, no stored fallback
+	params.memoryBudget = 0;
+	params.maxMatrixRankStored = 0;
+
+	timeEngine<Dmrg::MatrixVectorStored<ModelType> >("MatrixVectorStored",
+	                                                  model,
+	                                                  hc,
+	                                                  MatrixVectorEngineSelectorType::ENGINE_STORED,
+	                                                  products);
+	timeEngine<Dmrg::MatrixVectorKron<ModelType> >("MatrixVectorKron",
+	                                                model,
+	                                                hc,
+	                                                MatrixVectorEngineSelectorType::ENGINE_KRON,
+	                                                products);
+	// KronMatrix uses BatchedGemm2 when BatchedGemm is in SolverOptions
+	const PsimagLite::String options = params.options;
+	params.options += ",BatchedGemm";
+	timeEngine<Dmrg::MatrixVectorKron<ModelType> >("MatrixVectorKron+Batched",
+	                                                model,
+	                                                hc,
+	                                                MatrixVectorEngineSelectorType::ENGINE_KRON,
+	                                                products);
+	params.options = options;
+	timeEngine<Dmrg::MatrixVectorOnTheFly<ModelType> >("MatrixVectorOnTheFly",
+	                                                    model,
+	                                                    hc,
+	                                                    MatrixVectorEngineSelectorType::ENGINE_ONTHEFLY,
+	                                                    products);
+}
+
+template<typename MySparseMatrix>
+void main1(InputNgType::Readable& io,
+           ParametersDmrgSolverType& dmrgSolverParams,
+           SizeType products)
+{
+	typedef typename MySparseMatrix::value_type ComplexOrRealType;
+	typedef PsimagLite::Geometry<ComplexOrRealType,
+	        InputNgType::Readable,
+	        Dmrg::ProgramGlobals> GeometryType;
+	typedef Dmrg::Basis<MySparseMatrix> BasisType;
+	typedef Dmrg::Operators<BasisType> OperatorsType;
+	typedef Dmrg::BasisWithOperators<OperatorsType> BasisWithOperatorsType;
+	typedef Dmrg::LeftRightSuper<BasisWithOperatorsType,BasisType> LeftRightSuperType;
+	typedef Dmrg::ModelHelperLocal<LeftRightSuperType> ModelHelperType;
+	typedef Dmrg::ModelBase<ModelHelperType,
+	        ParametersDmrgSolverType,
+	        InputNgType::Readable,
+	        GeometryType> ModelBaseType;
+
+	GeometryType geometry(io);
+	Dmrg::ModelSelector<ModelBaseType> modelSelector(dmrgSolverParams.model);
+	const ModelBaseType& model = modelSelector(dmrgSolverParams, io, geometry);
+
+	PsimagLite::IoSelector::In dataIo(dmrgSolverParams.filename);
+	bool iscomplex = false;
+	dataIo.read(iscomplex, "IsComplex");
+	dataIo.close();
+	if (iscomplex != PsimagLite::IsComplexNumber<ComplexOrRealType>::True)
+		err("Previous run was complex and this one is not (or viceversa)\n");
+
+	benchStep(model, dmrgSolverParams, products);
+}
+
+void usage(const PsimagLite::String& name)
+{
+	std::cerr<<"USAGE is "<<name<<" -f filename [-n products] [-o solverOptions] [-V]\n";
+}
+
+/* PSIDOC MatrixVectorBench
+The program matrixVectorBench times the matrix vector engines of DMRG++,
+MatrixVectorStored, MatrixVectorKron, MatrixVectorKron with BatchedGemm,
+and MatrixVectorOnTheFly, on the largest symmetry sector of the
+superblock made of the checkpointed system and environ of a previous run.
+\begin{verbatim}
+./matrixVectorBench -f input.inp -n 20
+\end{verbatim}
+The command line arguments of matrixVectorBench are the following.
+\begin{itemize}
+\item[-f] [Mandatory, String] Input to use. The file
+ referred to by \verb!OutputFile=! is now an input, and must be present.
+\item[-n] [Optional, Integer] Number of products per engine, 10 by default.
+\item[-o] {[}Optional, String{]} Extra options for SolverOptions
+\item[-V] [Optional] Print version and exit
+\end{itemize}
+For each engine it prints the setup time, the time per product, and
+the GFLOP/s and memory estimated by MatrixVectorEngineSelector.
+The threads are those of \verb!Threads=! in the input.
+SU(2) runs are not supported.
+*/
+int main(int argc,char **argv)
+{
+	using namespace Dmrg;
+	PsimagLite::PsiApp application("matrixVectorBench",&argc,&argv,1);
+	PsimagLite::String filename;
+	PsimagLite::String sOptions;
+	SizeType products = 10;
+	bool versionOnly = false;
+	int opt = 0;
+
+	while ((opt = getopt(argc, argv,"f:n:o:V")) != -1) {
+		switch (opt) {
+		case 'f':
+			filename = optarg;
+			break;
+		case 'n':
+			products = atoi(optarg);
+			break;
+		case 'o':
+			sOptions += optarg;
+			break;
+		case 'V':
+			versionOnly = true;
+			break;
+		default:
+			usage(application.name());
+			return 1;
+		}
+	}
+
+	if (filename == "" && !versionOnly) {
+		usage(application.name());
+		return 1;
+	}
+
+	if (ConcurrencyType::root()) {
+		Provenance provenance;
+		std::cout<<provenance;
+		std::cout<<Provenance::logo(application.name())<<"\n";
+		application.checkMicroArch(std::cout, Provenance::compiledMicroArch());
+	}
+
+	if (versionOnly) return 0;
+
+	application.printCmdLine(std::cout);
+
+	InputCheck inputCheck;
+	InputNgType::Writeable ioWriteable(filename,
+	                                   inputCheck,
+	                                   "InputStartsHere",
+	                                   "InputEndsHere");
+	InputNgType::Readable io(ioWriteable);
+
+	ParametersDmrgSolverType dmrgSolverParams(io, sOptions, false, true);
+
+	int su2 = 0;
+	try {
+		io.readline(su2,"UseSu2Symmetry=");
+	} catch (std::exception&) {}
+
+	if (su2 > 0)
+		err("matrixVectorBench: SU(2) runs are not supported\n");
+
+	PsimagLite::CodeSectionParams codeSectionParams(dmrgSolverParams.nthreads);
+	ConcurrencyType::setOptions(codeSectionParams);
+
+	typedef PsimagLite::CrsMatrix<std::complex<RealType> > MySparseMatrixComplex;
+	typedef PsimagLite::CrsMatrix<RealType> MySparseMatrixReal;
+
+	bool isComplex = (dmrgSolverParams.options.find("useComplex") != PsimagLite::String::npos);
+	if (dmrgSolverParams.options.find("TimeStepTargeting") != PsimagLite::String::npos)
+		isComplex = true;
+
+	if (isComplex)
+		main1<MySparseMatrixComplex>(io, dmrgSolverParams, products);
+	else
+		main1<MySparseMatrixReal>(io, dmrgSolverParams, products);
+}